@@ -0,0 +1,200 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTDecorator_AbilitySystemTagBase.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+
+
+
+UBTDecorator_AbilitySystemTagBase::UBTDecorator_AbilitySystemTagBase()
+{
+	NodeName = TEXT("Native Ability System Tag");
+
+	bNotifyBecomeRelevant = true;
+	bNotifyCeaseRelevant = true;
+
+	INIT_DECORATOR_NODE_NOTIFY_FLAGS();
+
+	// 条件由标签事件驱动，允许打断自身与低优先级分支
+	bAllowAbortNone = true;
+	bAllowAbortLowerPri = true;
+	bAllowAbortChildNodes = true;
+
+	ActorToCheck.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, ActorToCheck), AActor::StaticClass());
+	ActorToCheck.AllowNoneAsValue(true);
+	ActorToCheck.SelectedKeyName = NAME_None;
+	
+}
+
+void UBTDecorator_AbilitySystemTagBase::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (UBlackboardData* BBAsset = GetBlackboardAsset())
+	{
+		ActorToCheck.ResolveSelectedKey(*BBAsset);
+	}
+}
+
+uint16 UBTDecorator_AbilitySystemTagBase::GetInstanceMemorySize() const
+{
+	return sizeof(FAbilitySystemTagDecoratorMemory);
+}
+
+void UBTDecorator_AbilitySystemTagBase::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FAbilitySystemTagDecoratorMemory>(NodeMemory, InitType);
+}
+
+void UBTDecorator_AbilitySystemTagBase::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	UnregisterTagEvents(CastInstanceNodeMemory<FAbilitySystemTagDecoratorMemory>(NodeMemory));
+
+	CleanupNodeMemory<FAbilitySystemTagDecoratorMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTDecorator_AbilitySystemTagBase::GetActorDescription() const
+{
+	return ActorToCheck.IsSet() ? ActorToCheck.SelectedKeyName.ToString() : TEXT("Controlled Pawn");
+	
+}
+
+bool UBTDecorator_AbilitySystemTagBase::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	const UAbilitySystemComponent* ASC = GetAbilitySystemComponentToCheck(OwnerComp);
+
+	return ASC ? EvaluateTags(*ASC) : false;
+	
+}
+
+void UBTDecorator_AbilitySystemTagBase::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (FlowAbortMode == EBTFlowAbortMode::None)
+	{
+		return;
+	}
+
+	RegisterTagEvents(OwnerComp, CastInstanceNodeMemory<FAbilitySystemTagDecoratorMemory>(NodeMemory));
+
+	if (ShouldObserveActorToCheck())
+	{
+		if (UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent())
+		{
+			BlackboardComp->RegisterObserver(ActorToCheck.GetSelectedKeyID(), this,
+				FOnBlackboardChangeNotification::CreateUObject(this, &UBTDecorator_AbilitySystemTagBase::OnActorToCheckChanged));
+		}
+	}
+}
+
+void UBTDecorator_AbilitySystemTagBase::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	UnregisterTagEvents(CastInstanceNodeMemory<FAbilitySystemTagDecoratorMemory>(NodeMemory));
+
+	if (ShouldObserveActorToCheck())
+	{
+		if (UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent())
+		{
+			BlackboardComp->UnregisterObserversFrom(this);
+		}
+	}
+}
+
+UAbilitySystemComponent* UBTDecorator_AbilitySystemTagBase::GetAbilitySystemComponentToCheck(const UBehaviorTreeComponent& OwnerComp) const
+{
+	AActor* Actor = nullptr;
+
+	if (ActorToCheck.IsSet())
+	{
+		const UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+		Actor = BlackboardComp ? Cast<AActor>(BlackboardComp->GetValueAsObject(ActorToCheck.SelectedKeyName)) : nullptr;
+	}
+	else if (const AAIController* AIController = OwnerComp.GetAIOwner())
+	{
+		Actor = AIController->GetPawn();
+	}
+
+	return Actor ? UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Actor) : nullptr;
+	
+}
+
+void UBTDecorator_AbilitySystemTagBase::RegisterTagEvents(UBehaviorTreeComponent& OwnerComp, FAbilitySystemTagDecoratorMemory* Memory) const
+{
+	UnregisterTagEvents(Memory);
+
+	UAbilitySystemComponent* ASC = GetAbilitySystemComponentToCheck(OwnerComp);
+
+	if (!ASC)
+	{
+		return;
+	}
+
+	TArray<FGameplayTag> ObservedTags;
+	GetObservedTags(ObservedTags);
+
+	Memory->ObservedASC = ASC;
+
+	// 父标签的计数包含子标签，监听查询中出现的标签即可覆盖其所有子标签的变化
+	for (const FGameplayTag& ObservedTag : ObservedTags)
+	{
+		const FDelegateHandle TagEventHandle = ASC->RegisterGameplayTagEvent(ObservedTag, EGameplayTagEventType::NewOrRemoved)
+			.AddUObject(this, &UBTDecorator_AbilitySystemTagBase::OnObservedTagChanged, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp));
+
+		Memory->TagEventHandles.Emplace(ObservedTag, TagEventHandle);
+	}
+}
+
+void UBTDecorator_AbilitySystemTagBase::UnregisterTagEvents(FAbilitySystemTagDecoratorMemory* Memory) const
+{
+	if (UAbilitySystemComponent* ASC = Memory->ObservedASC.Get())
+	{
+		for (const TPair<FGameplayTag, FDelegateHandle>& TagEventHandle : Memory->TagEventHandles)
+		{
+			ASC->UnregisterGameplayTagEvent(TagEventHandle.Value, TagEventHandle.Key, EGameplayTagEventType::NewOrRemoved);
+		}
+	}
+
+	Memory->ObservedASC.Reset();
+	Memory->TagEventHandles.Reset();
+}
+
+void UBTDecorator_AbilitySystemTagBase::OnObservedTagChanged(const FGameplayTag InTag, int32 InNewCount, TWeakObjectPtr<UBehaviorTreeComponent> InOwnerComp) const
+{
+	if (UBehaviorTreeComponent* OwnerComp = InOwnerComp.Get())
+	{
+		// 只在条件结果与当前分支状态不一致时请求重新执行
+		ConditionalFlowAbort(*OwnerComp, EBTDecoratorAbortRequest::ConditionResultChanged);
+	}
+}
+
+EBlackboardNotificationResult UBTDecorator_AbilitySystemTagBase::OnActorToCheckChanged(const UBlackboardComponent& InBlackboard, FBlackboard::FKey InChangedKeyID)
+{
+	UBehaviorTreeComponent* OwnerComp = Cast<UBehaviorTreeComponent>(InBlackboard.GetBrainComponent());
+
+	if (!OwnerComp)
+	{
+		return EBlackboardNotificationResult::RemoveObserver;
+	}
+
+	uint8* NodeMemory = OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this));
+
+	if (NodeMemory)
+	{
+		RegisterTagEvents(*OwnerComp, CastInstanceNodeMemory<FAbilitySystemTagDecoratorMemory>(NodeMemory));
+	}
+
+	ConditionalFlowAbort(*OwnerComp, EBTDecoratorAbortRequest::ConditionResultChanged);
+
+	return EBlackboardNotificationResult::ContinueObserving;
+	
+}
+
+bool UBTDecorator_AbilitySystemTagBase::ShouldObserveActorToCheck() const
+{
+	return ActorToCheck.IsSet() && FlowAbortMode != EBTFlowAbortMode::None;
+	
+}
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTDecorator_AbilitySystemTagQuery.h"
+#include "AbilitySystemComponent.h"
+
+
+
+UBTDecorator_AbilitySystemTagQuery::UBTDecorator_AbilitySystemTagQuery()
+{
+	NodeName = TEXT("Native Gameplay Tag Query");
+	
+}
+
+void UBTDecorator_AbilitySystemTagQuery::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	QueryTags.Reset();
+	TagQuery.GetGameplayTagArray(QueryTags);
+}
+
+FString UBTDecorator_AbilitySystemTagQuery::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s %s %s"), *Super::GetStaticDescription(), *GetActorDescription(),
+		IsInversed() ? TEXT("does not match") : TEXT("matches"), *TagQuery.GetDescription());
+	
+}
+
+void UBTDecorator_AbilitySystemTagQuery::GetObservedTags(TArray<FGameplayTag>& OutTags) const
+{
+	OutTags.Append(QueryTags);
+}
+
+bool UBTDecorator_AbilitySystemTagQuery::EvaluateTags(const UAbilitySystemComponent& InASC) const
+{
+	return !TagQuery.IsEmpty() && TagQuery.Matches(InASC.GetOwnedGameplayTags());
+	
+}
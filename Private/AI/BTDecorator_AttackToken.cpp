@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTDecorator_AttackToken.h"
+#include "AIController.h"
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+
+
+
+UBTDecorator_AttackToken::UBTDecorator_AttackToken()
+{
+	NodeName = TEXT("Native Attack Token");
+
+	bNotifyBecomeRelevant = true;
+	bNotifyCeaseRelevant = true;
+
+	INIT_DECORATOR_NODE_NOTIFY_FLAGS();
+
+	// 进入分支时名额可能已被同一帧的其他敌人拿走，需要能打断自身分支
+	bAllowAbortNone = false;
+	bAllowAbortLowerPri = false;
+	bAllowAbortChildNodes = true;
+	FlowAbortMode = EBTFlowAbortMode::Self;
+
+	TokenType = EWarriorAttackTokenType::Melee;
+	
+}
+
+void UBTDecorator_AttackToken::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (IsInversed())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s in %s does not support Inverse Condition, the inversion is ignored"), *GetNodeName(), *GetNameSafe(&Asset));
+	}
+}
+
+uint16 UBTDecorator_AttackToken::GetInstanceMemorySize() const
+{
+	return sizeof(FAttackTokenDecoratorMemory);
+}
+
+void UBTDecorator_AttackToken::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FAttackTokenDecoratorMemory>(NodeMemory, InitType);
+}
+
+void UBTDecorator_AttackToken::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FAttackTokenDecoratorMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTDecorator_AttackToken::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Requires a %s attack token"), *UEnum::GetDisplayValueAsText(TokenType).ToString());
+	
+}
+
+bool UBTDecorator_AttackToken::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	const FAttackTokenDecoratorMemory* Memory = CastInstanceNodeMemory<FAttackTokenDecoratorMemory>(NodeMemory);
+
+	bool bCanEnterBranch = true;
+
+	if (Memory->bIsRelevant)
+	{
+		// 分支执行期间以进入时的申请结果为准
+		bCanEnterBranch = Memory->bHoldsToken;
+	}
+	else
+	{
+		const AAIController* AIController = OwnerComp.GetAIOwner();
+		const APawn* OwningPawn = AIController ? AIController->GetPawn() : nullptr;
+		UWarriorAttackTokenSubsystem* AttackTokenSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>();
+
+		if (OwningPawn && AttackTokenSubsystem)
+		{
+			bCanEnterBranch = AttackTokenSubsystem->CanAcquireAttackToken(OwningPawn, TokenType);
+
+			// 只登记等待的开始时间，同一敌人持续等待只计一次
+			if (!bCanEnterBranch)
+			{
+				AttackTokenSubsystem->MarkWaitingForAttackToken(OwningPawn, TokenType);
+			}
+		}
+	}
+
+	// 行为树会对结果再做一次反转，这里预先抵消，使反转条件不起作用
+	return IsInversed() ? !bCanEnterBranch : bCanEnterBranch;
+	
+}
+
+void UBTDecorator_AttackToken::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FAttackTokenDecoratorMemory* Memory = CastInstanceNodeMemory<FAttackTokenDecoratorMemory>(NodeMemory);
+
+	const AAIController* AIController = OwnerComp.GetAIOwner();
+	const APawn* OwningPawn = AIController ? AIController->GetPawn() : nullptr;
+	UWarriorAttackTokenSubsystem* AttackTokenSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>();
+
+	Memory->bIsRelevant = true;
+	Memory->bHoldsToken = !OwningPawn || !AttackTokenSubsystem || AttackTokenSubsystem->TryAcquireAttackToken(OwningPawn, TokenType);
+
+	if (!Memory->bHoldsToken)
+	{
+		ConditionalFlowAbort(OwnerComp, EBTDecoratorAbortRequest::ConditionResultChanged);
+	}
+}
+
+void UBTDecorator_AttackToken::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FAttackTokenDecoratorMemory* Memory = CastInstanceNodeMemory<FAttackTokenDecoratorMemory>(NodeMemory);
+
+	const AAIController* AIController = OwnerComp.GetAIOwner();
+
+	if (Memory->bHoldsToken && AIController)
+	{
+		if (UWarriorAttackTokenSubsystem* AttackTokenSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>())
+		{
+			AttackTokenSubsystem->ReleaseAttackToken(AIController->GetPawn(), TokenType);
+		}
+	}
+
+	Memory->bIsRelevant = false;
+	Memory->bHoldsToken = false;
+
+	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
+}
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTDecorator_HasAbilitySystemTag.h"
+#include "AbilitySystemComponent.h"
+
+
+
+UBTDecorator_HasAbilitySystemTag::UBTDecorator_HasAbilitySystemTag()
+{
+	NodeName = TEXT("Native Has Gameplay Tag");
+	
+}
+
+FString UBTDecorator_HasAbilitySystemTag::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s %s %s"), *Super::GetStaticDescription(), *GetActorDescription(),
+		IsInversed() ? TEXT("does not have") : TEXT("has"), *TagToCheck.ToString());
+	
+}
+
+void UBTDecorator_HasAbilitySystemTag::GetObservedTags(TArray<FGameplayTag>& OutTags) const
+{
+	if (TagToCheck.IsValid())
+	{
+		OutTags.Add(TagToCheck);
+	}
+}
+
+bool UBTDecorator_HasAbilitySystemTag::EvaluateTags(const UAbilitySystemComponent& InASC) const
+{
+	return TagToCheck.IsValid() && InASC.GetTagCount(TagToCheck) > 0;
+	
+}
@@ -5,7 +5,7 @@
 #include "AIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BlackboardData.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Subsystems/WarriorOrientationSubsystem.h"
 
 
 
@@ -16,8 +16,10 @@ UBTService_OrientToTargetActor::UBTService_OrientToTargetActor()
 	INIT_SERVICE_NODE_NOTIFY_FLAGS();
 
 	RotationInterpSpeed = 5.0f;
-	Interval = 0.f;
-	RandomDeviation = 0.f;
+
+	// 转向由子系统每帧完成，服务只需要偶尔检查目标是否变化
+	Interval = 0.25f;
+	RandomDeviation = 0.05f;
 	
 	InTargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, InTargetActorKey),
 		AActor::StaticClass());
@@ -37,6 +39,11 @@ void UBTService_OrientToTargetActor::InitializeFromAsset(UBehaviorTree& Asset)
 	}
 }
 
+uint16 UBTService_OrientToTargetActor::GetInstanceMemorySize() const
+{
+	return sizeof(FOrientToTargetActorServiceMemory);
+}
+
 FString UBTService_OrientToTargetActor::GetStaticDescription() const
 {
 	const FString KeyDescription = InTargetActorKey.SelectedKeyName.ToString();
@@ -46,25 +53,60 @@ FString UBTService_OrientToTargetActor::GetStaticDescription() const
 	
 }
 
+void UBTService_OrientToTargetActor::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
+
+	FOrientToTargetActorServiceMemory* Memory = CastInstanceNodeMemory<FOrientToTargetActorServiceMemory>(NodeMemory);
+	Memory->OrientRequestId = 0;
+
+	RefreshOrientRequest(OwnerComp, Memory);
+}
+
+void UBTService_OrientToTargetActor::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FOrientToTargetActorServiceMemory* Memory = CastInstanceNodeMemory<FOrientToTargetActorServiceMemory>(NodeMemory);
+
+	if (UWarriorOrientationSubsystem* OrientationSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>())
+	{
+		OrientationSubsystem->RemoveOrientRequest(Memory->OrientRequestId);
+	}
+
+	Memory->OrientRequestId = 0;
+
+	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
+}
+
 void UBTService_OrientToTargetActor::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
 	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
 
+	RefreshOrientRequest(OwnerComp, CastInstanceNodeMemory<FOrientToTargetActorServiceMemory>(NodeMemory));
+}
+
+void UBTService_OrientToTargetActor::RefreshOrientRequest(UBehaviorTreeComponent& OwnerComp, FOrientToTargetActorServiceMemory* Memory) const
+{
+	UWarriorOrientationSubsystem* OrientationSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>();
+
+	if (!OrientationSubsystem)
+	{
+		return;
+	}
+
 	UObject* ActorObject = OwnerComp.GetBlackboardComponent()->GetValueAsObject(InTargetActorKey.SelectedKeyName);
 	AActor* TargetActor = Cast<AActor>(ActorObject);
 
 	APawn* OwningPawn = OwnerComp.GetAIOwner()->GetPawn();
 
-	if (OwningPawn && TargetActor)
+	if (!OwningPawn || !TargetActor)
 	{
-		const FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(OwningPawn->GetActorLocation(),
-			TargetActor->GetActorLocation());
-
-		const FRotator TargetRot = FMath::RInterpTo(OwningPawn->GetActorRotation(), LookAtRot,
-			DeltaSeconds, RotationInterpSpeed);
-
-		OwningPawn->SetActorRotation(TargetRot);
+		OrientationSubsystem->RemoveOrientRequest(Memory->OrientRequestId);
+		Memory->OrientRequestId = 0;
+		return;
 	}
 
-	
-}
\ No newline at end of file
+	if (!OrientationSubsystem->UpdateOrientRequestTarget(Memory->OrientRequestId, TargetActor))
+	{
+		Memory->OrientRequestId = OrientationSubsystem->AddOrientRequest(OwningPawn, TargetActor, RotationInterpSpeed);
+	}
+}
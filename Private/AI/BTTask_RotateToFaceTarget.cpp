@@ -5,7 +5,7 @@
 #include "AIController.h"
 #include"BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BlackboardData.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Subsystems/WarriorOrientationSubsystem.h"
 
 UBTTask_RotateToFaceTarget::UBTTask_RotateToFaceTarget()
 {
@@ -13,7 +13,8 @@ UBTTask_RotateToFaceTarget::UBTTask_RotateToFaceTarget()
 	AnglePrecision = 10.0f;
 	RotationInterpSpeed = 5.0f;
 
-	bNotifyTick = true;
+	// 转向由子系统完成，任务本身不需要每帧更新
+	bNotifyTick = false;
 	bNotifyTaskFinished = true;
 	bCreateNodeInstance = false;
 
@@ -60,55 +61,61 @@ EBTNodeResult::Type UBTTask_RotateToFaceTarget::ExecuteTask(UBehaviorTreeCompone
 
 	Memory->OwningPawn = OwningPawn;
 	Memory->TargetActor = TargetActor;
+	Memory->OrientRequestId = 0;
 
 	if (!Memory->IsValid())
 	{
 		return EBTNodeResult::Failed;
 	}
 
-	if (HasReachedAnglePrecision(OwningPawn, TargetActor))
+	if (UWarriorOrientationSubsystem::IsFacingTarget(OwningPawn, TargetActor, AnglePrecision))
 	{
 		Memory->Reset();
 		return EBTNodeResult::Succeeded;
 	}
 
+	UWarriorOrientationSubsystem* OrientationSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>();
+
+	if (!OrientationSubsystem)
+	{
+		Memory->Reset();
+		return EBTNodeResult::Failed;
+	}
+
+	// 子系统回调前已移除该请求，这里只需要结束任务
+	Memory->OrientRequestId = OrientationSubsystem->AddOrientRequest(OwningPawn, TargetActor, RotationInterpSpeed, AnglePrecision,
+		FOnOrientRequestFinishedDelegate::CreateWeakLambda(&OwnerComp, [this, &OwnerComp](bool bSucceeded)
+		{
+			FinishLatentTask(OwnerComp, bSucceeded ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+		}));
+
 	return EBTNodeResult::InProgress;
 	
 }
 
-void UBTTask_RotateToFaceTarget::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+EBTNodeResult::Type UBTTask_RotateToFaceTarget::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-	FRotateToFaceTargetTaskMemory* Memory = CastInstanceNodeMemory<FRotateToFaceTargetTaskMemory>(NodeMemory);
-
-	if (!Memory->IsValid())
-	{
-		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
-	}
+	RemoveOrientRequest(OwnerComp, CastInstanceNodeMemory<FRotateToFaceTargetTaskMemory>(NodeMemory));
 
-	if (HasReachedAnglePrecision(Memory->OwningPawn.Get(), Memory->TargetActor.Get()))
-	{
-		Memory->Reset();
-		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-	}
-	else
-	{
-		const FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(Memory->OwningPawn->GetActorLocation(), Memory->TargetActor->GetActorLocation());
-		const FRotator TargetRot = FMath::RInterpTo(Memory->OwningPawn->GetActorRotation(), LookAtRot, DeltaSeconds, RotationInterpSpeed);
-
-		Memory->OwningPawn->SetActorRotation(TargetRot);
-		
-	}
+	return Super::AbortTask(OwnerComp, NodeMemory);
 }
 
-bool UBTTask_RotateToFaceTarget::HasReachedAnglePrecision(APawn* QueryPawn, AActor* TargetActor) const
+void UBTTask_RotateToFaceTarget::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
 {
-	const FVector OwnerForward = QueryPawn->GetActorForwardVector();
-	const FVector OwnerToTargetNormalized = (TargetActor->GetActorLocation() - QueryPawn->GetActorLocation()).GetSafeNormal();
+	RemoveOrientRequest(OwnerComp, CastInstanceNodeMemory<FRotateToFaceTargetTaskMemory>(NodeMemory));
 
-	const float DotResult = FVector::DotProduct(OwnerForward, OwnerToTargetNormalized);
-	const float AngleDiff = UKismetMathLibrary::DegAcos(DotResult);
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
 
-	return AngleDiff <= AnglePrecision;
+void UBTTask_RotateToFaceTarget::RemoveOrientRequest(UBehaviorTreeComponent& OwnerComp, FRotateToFaceTargetTaskMemory* Memory) const
+{
+	if (Memory->OrientRequestId != 0)
+	{
+		if (UWarriorOrientationSubsystem* OrientationSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>())
+		{
+			OrientationSubsystem->RemoveOrientRequest(Memory->OrientRequestId);
+		}
+	}
 
-	
+	Memory->Reset();
 }
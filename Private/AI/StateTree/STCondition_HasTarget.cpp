@@ -0,0 +1,16 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/StateTree/STCondition_HasTarget.h"
+
+#include "Controllers/WarriorAIController.h"
+#include "StateTreeExecutionContext.h"
+
+bool FSTCondition_HasTarget::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	const bool bHasTarget = InstanceData.AIController && InstanceData.AIController->HasTargetActor();
+
+	return bHasTarget != bInvert;
+}
@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/StateTree/STCondition_TargetInRange.h"
+
+#include "Controllers/WarriorAIController.h"
+#include "StateTreeExecutionContext.h"
+
+bool FSTCondition_TargetInRange::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	const APawn* OwningPawn = InstanceData.AIController ? InstanceData.AIController->GetPawn() : nullptr;
+
+	if (!OwningPawn || !InstanceData.TargetActor)
+	{
+		return bInvert;
+	}
+
+	const float DistanceSquared = FVector::DistSquared(OwningPawn->GetActorLocation(), InstanceData.TargetActor->GetActorLocation());
+
+	const bool bInRange = DistanceSquared >= FMath::Square(InstanceData.MinDistance) && DistanceSquared <= FMath::Square(InstanceData.MaxDistance);
+
+	return bInRange != bInvert;
+}
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/StateTree/STTask_AcquireTarget.h"
+
+#include "Controllers/WarriorAIController.h"
+#include "StateTreeExecutionContext.h"
+
+EStateTreeRunStatus FSTTask_AcquireTarget::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	return PollTarget(Context);
+}
+
+EStateTreeRunStatus FSTTask_AcquireTarget::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	return PollTarget(Context);
+}
+
+EStateTreeRunStatus FSTTask_AcquireTarget::PollTarget(FStateTreeExecutionContext& Context) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	if (!InstanceData.AIController)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	InstanceData.TargetActor = InstanceData.AIController->GetTargetActor();
+
+	return InstanceData.TargetActor ? EStateTreeRunStatus::Succeeded : EStateTreeRunStatus::Running;
+}
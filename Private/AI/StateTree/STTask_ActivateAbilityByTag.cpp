@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/StateTree/STTask_ActivateAbilityByTag.h"
+
+#include "AbilitySystem/WarriorAbilitySystemComponent.h"
+#include "Controllers/WarriorAIController.h"
+#include "StateTreeExecutionContext.h"
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+#include "WarriorFunctionLibrary.h"
+
+EStateTreeRunStatus FSTTask_ActivateAbilityByTag::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	InstanceData.bHoldsAttackToken = false;
+
+	APawn* OwningPawn = InstanceData.AIController ? InstanceData.AIController->GetPawn() : nullptr;
+	UWarriorAbilitySystemComponent* WarriorASC = UWarriorFunctionLibrary::NativeGetWarriorASCFromActor(OwningPawn);
+
+	if (!WarriorASC || !AbilityTag.IsValid())
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	UWarriorAttackTokenSubsystem* AttackTokenSubsystem = Context.GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>();
+
+	if (bRequireAttackToken && AttackTokenSubsystem)
+	{
+		if (!AttackTokenSubsystem->TryAcquireAttackToken(OwningPawn, AttackTokenType))
+		{
+			return EStateTreeRunStatus::Failed;
+		}
+
+		InstanceData.bHoldsAttackToken = true;
+	}
+
+	if (!WarriorASC->TryActivateAbilityByTag(AbilityTag))
+	{
+		// ExitState 会归还名额
+		return EStateTreeRunStatus::Failed;
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FSTTask_ActivateAbilityByTag::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	UWarriorAbilitySystemComponent* WarriorASC = UWarriorFunctionLibrary::NativeGetWarriorASCFromActor(
+		InstanceData.AIController ? InstanceData.AIController->GetPawn() : nullptr);
+
+	if (!WarriorASC)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	TArray<FGameplayAbilitySpec*> AbilitySpecs;
+	WarriorASC->GetActivatableGameplayAbilitySpecsByAllMatchingTags(AbilityTag.GetSingleTagContainer(), AbilitySpecs, false);
+
+	for (const FGameplayAbilitySpec* AbilitySpec : AbilitySpecs)
+	{
+		if (AbilitySpec->IsActive())
+		{
+			return EStateTreeRunStatus::Running;
+		}
+	}
+
+	return EStateTreeRunStatus::Succeeded;
+}
+
+void FSTTask_ActivateAbilityByTag::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	if (!InstanceData.bHoldsAttackToken)
+	{
+		return;
+	}
+
+	if (UWarriorAttackTokenSubsystem* AttackTokenSubsystem = Context.GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>())
+	{
+		AttackTokenSubsystem->ReleaseAttackToken(InstanceData.AIController ? InstanceData.AIController->GetPawn() : nullptr, AttackTokenType);
+	}
+
+	InstanceData.bHoldsAttackToken = false;
+}
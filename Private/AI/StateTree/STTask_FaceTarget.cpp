@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/StateTree/STTask_FaceTarget.h"
+
+#include "Controllers/WarriorAIController.h"
+#include "StateTreeExecutionContext.h"
+#include "Subsystems/WarriorOrientationSubsystem.h"
+
+EStateTreeRunStatus FSTTask_FaceTarget::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	InstanceData.OrientRequestId = 0;
+
+	APawn* OwningPawn = InstanceData.AIController ? InstanceData.AIController->GetPawn() : nullptr;
+
+	if (!OwningPawn || !InstanceData.TargetActor)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	if (InstanceData.bFinishWhenFacing && UWarriorOrientationSubsystem::IsFacingTarget(OwningPawn, InstanceData.TargetActor, InstanceData.AnglePrecision))
+	{
+		return EStateTreeRunStatus::Succeeded;
+	}
+
+	UWarriorOrientationSubsystem* OrientationSubsystem = Context.GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>();
+
+	if (!OrientationSubsystem)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	// 带角度精度的请求在朝向目标后由子系统自动移除，结束与否在 Tick 中判断
+	InstanceData.OrientRequestId = OrientationSubsystem->AddOrientRequest(OwningPawn, InstanceData.TargetActor, InstanceData.RotationInterpSpeed,
+		InstanceData.bFinishWhenFacing ? InstanceData.AnglePrecision : -1.f);
+
+	return InstanceData.OrientRequestId != 0 ? EStateTreeRunStatus::Running : EStateTreeRunStatus::Failed;
+}
+
+EStateTreeRunStatus FSTTask_FaceTarget::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	const APawn* OwningPawn = InstanceData.AIController ? InstanceData.AIController->GetPawn() : nullptr;
+
+	if (!OwningPawn || !IsValid(InstanceData.TargetActor))
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	if (InstanceData.bFinishWhenFacing && UWarriorOrientationSubsystem::IsFacingTarget(OwningPawn, InstanceData.TargetActor, InstanceData.AnglePrecision))
+	{
+		return EStateTreeRunStatus::Succeeded;
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+void FSTTask_FaceTarget::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	if (InstanceData.OrientRequestId != 0)
+	{
+		if (UWarriorOrientationSubsystem* OrientationSubsystem = Context.GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>())
+		{
+			OrientationSubsystem->RemoveOrientRequest(InstanceData.OrientRequestId);
+		}
+
+		InstanceData.OrientRequestId = 0;
+	}
+}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/StateTree/STTask_Strafe.h"
+
+#include "Controllers/WarriorAIController.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "NavigationSystem.h"
+#include "StateTreeExecutionContext.h"
+#include "Subsystems/WarriorOrientationSubsystem.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorGameplayTags.h"
+
+EStateTreeRunStatus FSTTask_Strafe::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	InstanceData.OrientRequestId = 0;
+	InstanceData.PreviousMaxWalkSpeed = 0.f;
+
+	ACharacter* OwningCharacter = InstanceData.AIController ? InstanceData.AIController->GetPawn<ACharacter>() : nullptr;
+	const UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(Context.GetWorld());
+
+	if (!OwningCharacter || !InstanceData.TargetActor || !NavigationSystem)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	FNavLocation StrafeLocation;
+
+	if (!NavigationSystem->GetRandomReachablePointInRadius(OwningCharacter->GetActorLocation(), InstanceData.StrafeRadius, StrafeLocation))
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	const EPathFollowingRequestResult::Type MoveResult = InstanceData.AIController->MoveToLocation(StrafeLocation.Location,
+		InstanceData.AcceptanceRadius, true, true, false, true);
+
+	if (MoveResult == EPathFollowingRequestResult::Failed)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	UWarriorFunctionLibrary::AddGameplayTagToActorIfNone(OwningCharacter, WarriorGameplayTags::Enemy_Status_Strafing);
+
+	UCharacterMovementComponent* MovementComponent = OwningCharacter->GetCharacterMovement();
+	InstanceData.PreviousMaxWalkSpeed = MovementComponent->MaxWalkSpeed;
+	MovementComponent->MaxWalkSpeed = InstanceData.StrafeWalkSpeed;
+
+	if (UWarriorOrientationSubsystem* OrientationSubsystem = Context.GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>())
+	{
+		InstanceData.OrientRequestId = OrientationSubsystem->AddOrientRequest(OwningCharacter, InstanceData.TargetActor, InstanceData.RotationInterpSpeed);
+	}
+
+	return MoveResult == EPathFollowingRequestResult::AlreadyAtGoal ? EStateTreeRunStatus::Succeeded : EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FSTTask_Strafe::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	if (!InstanceData.AIController || !IsValid(InstanceData.TargetActor))
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	return InstanceData.AIController->GetMoveStatus() == EPathFollowingStatus::Idle ? EStateTreeRunStatus::Succeeded : EStateTreeRunStatus::Running;
+}
+
+void FSTTask_Strafe::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	if (InstanceData.OrientRequestId != 0)
+	{
+		if (UWarriorOrientationSubsystem* OrientationSubsystem = Context.GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>())
+		{
+			OrientationSubsystem->RemoveOrientRequest(InstanceData.OrientRequestId);
+		}
+
+		InstanceData.OrientRequestId = 0;
+	}
+
+	if (!InstanceData.AIController)
+	{
+		return;
+	}
+
+	// 被其他状态打断时停在原地，不继续走向旧的横移点
+	if (InstanceData.AIController->GetMoveStatus() != EPathFollowingStatus::Idle)
+	{
+		InstanceData.AIController->StopMovement();
+	}
+
+	if (ACharacter* OwningCharacter = InstanceData.AIController->GetPawn<ACharacter>())
+	{
+		UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(OwningCharacter, WarriorGameplayTags::Enemy_Status_Strafing);
+
+		if (InstanceData.PreviousMaxWalkSpeed > 0.f)
+		{
+			OwningCharacter->GetCharacterMovement()->MaxWalkSpeed = InstanceData.PreviousMaxWalkSpeed;
+		}
+	}
+}
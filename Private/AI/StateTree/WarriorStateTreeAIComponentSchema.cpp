@@ -0,0 +1,15 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/StateTree/WarriorStateTreeAIComponentSchema.h"
+
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Controllers/WarriorAIController.h"
+
+UWarriorStateTreeAIComponentSchema::UWarriorStateTreeAIComponentSchema(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// 上下文描述中的类型在 PostLoad 时按这两个类更新
+	ContextActorClass = AWarriorEnemyCharacter::StaticClass();
+	AIControllerClass = AWarriorAIController::StaticClass();
+}
@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/WarriorCrowdManager.h"
+
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Simulation"), STAT_WarriorCrowdSimulation, STATGROUP_WarriorSurvival);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Crowd Simulation (ms)"), STAT_WarriorCrowdSimulationMs, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Agents"), STAT_WarriorCrowdAgents, STATGROUP_WarriorSurvival);
+
+void UWarriorCrowdManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorCrowdSimulation);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Super::Tick(DeltaTime);
+
+	LastSimulationTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	SET_FLOAT_STAT(STAT_WarriorCrowdSimulationMs, LastSimulationTimeMs);
+	SET_DWORD_STAT(STAT_WarriorCrowdAgents, ActiveAgents.Num());
+}
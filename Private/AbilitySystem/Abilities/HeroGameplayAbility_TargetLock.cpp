@@ -13,6 +13,9 @@
 #include "Characters/WarriorHeroCharacter.h"
 #include "Components/SizeBox.h"
 #include "Controllers/WarriorHeroController.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "DrawDebugHelpers.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
@@ -133,31 +136,36 @@ void UHeroGameplayAbility_TargetLock::TryLockOnTarget()
 void UHeroGameplayAbility_TargetLock::GetAvailableActorsToLock()
 {
 	AvailableActorsToLock.Empty();
-	
 
-	TArray<FHitResult> BoxTraceHits;
-	
-	UKismetSystemLibrary::BoxTraceMultiForObjects(GetHeroCharacterFromActorInfo(),
-		GetHeroCharacterFromActorInfo()->GetActorLocation(),
-		GetHeroCharacterFromActorInfo()->GetActorLocation() + GetHeroCharacterFromActorInfo()->GetActorForwardVector() * BoxTraceDistance,
-		TraceBoxSize / 2.0f, GetHeroCharacterFromActorInfo()->GetActorForwardVector().ToOrientationRotator(),
-		BoxTraceChannel, false,
-		TArray<AActor*>(), bShowPersistentDebugShape ? EDrawDebugTrace::Persistent : EDrawDebugTrace::None,
-		BoxTraceHits, true);
-
-	for (const FHitResult& TraceHit : BoxTraceHits)
+	const AWarriorHeroCharacter* HeroCharacter = GetHeroCharacterFromActorInfo();
+
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = HeroCharacter->GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+
+	if (!EnemyRegistrySubsystem)
 	{
-		if (AActor* HitActor = TraceHit.GetActor())
-		{
-			if (HitActor != GetHeroCharacterFromActorInfo())
-			{
-				AvailableActorsToLock.AddUnique(HitActor);
-				
-				// Debug::Print(HitActor->GetActorNameOrLabel());
-			}
-		}
+		return;
+	}
+
+	// 与原先沿朝向扫过 BoxTraceDistance 的盒体覆盖同一片区域，改为查询存活敌人登记表，不再发起物理检测
+	// 只有登记过的敌人可以被锁定，不再按对象通道筛选其他 Actor
+	const FVector HeroForward = HeroCharacter->GetActorForwardVector();
+	const FQuat BoxRotation = HeroForward.ToOrientationQuat();
+	const FVector BoxCenter = HeroCharacter->GetActorLocation() + HeroForward * (BoxTraceDistance / 2.f);
+	const FVector BoxHalfExtent = TraceBoxSize / 2.f + FVector(BoxTraceDistance / 2.f, 0.f, 0.f);
+
+	if (bShowPersistentDebugShape)
+	{
+		DrawDebugBox(HeroCharacter->GetWorld(), BoxCenter, BoxHalfExtent, BoxRotation, FColor::Red, true);
+	}
+
+	TArray<AWarriorEnemyCharacter*> EnemiesInBox;
+
+	EnemyRegistrySubsystem->QueryEnemiesInBox(BoxCenter, BoxRotation, BoxHalfExtent, EnemiesInBox);
+
+	for (AWarriorEnemyCharacter* EnemyInBox : EnemiesInBox)
+	{
+		AvailableActorsToLock.Add(EnemyInBox);
 	}
-	
 }
 
 void UHeroGameplayAbility_TargetLock::CancelTargetLockAbility()
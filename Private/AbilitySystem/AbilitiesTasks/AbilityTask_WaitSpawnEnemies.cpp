@@ -3,10 +3,9 @@
 
 #include "AbilitySystem/AbilitiesTasks/AbilityTask_WaitSpawnEnemies.h"
 
-#include "NavigationSystem.h"
-#include "Engine/AssetManager.h"
 #include "WarriorDebugHelper.h"
 #include "Engine/StreamableManager.h"
+#include "Subsystems/WarriorEnemyPoolSubsystem.h"
 
 UAbilityTask_WaitSpawnEnemies* UAbilityTask_WaitSpawnEnemies::WaitSpawnEnemies(UGameplayAbility* OwningAbility,
    FGameplayTag EventTag, TSoftClassPtr<AWarriorEnemyCharacter> SoftEnemyClassToSpawn, int32 NumToSpawn,
@@ -27,7 +26,13 @@ void UAbilityTask_WaitSpawnEnemies::Activate()
 	FGameplayEventMulticastDelegate& Delegate = AbilitySystemComponent->GenericGameplayEventCallbacks.FindOrAdd(CachedEventTag);
 
 	DelegateHandle = Delegate.AddUObject(this, &ThisClass::OnGameplayEventReceived);
-	
+
+	// 提前加载并预热，等事件到来时敌人类别已经常驻、池中已有休眠实例
+	if (UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>())
+	{
+		EnemyPoolSubsystem->RequestEnemyClassLoad(CachedSoftEnemyClassToSpawn,
+			FStreamableDelegate::CreateUObject(this, &ThisClass::OnEnemyClassLoaded));
+	}
 }
 
 void UAbilityTask_WaitSpawnEnemies::OnDestroy(bool bInOwnerFinished)
@@ -39,15 +44,14 @@ void UAbilityTask_WaitSpawnEnemies::OnDestroy(bool bInOwnerFinished)
 	Super::OnDestroy(bInOwnerFinished);
 }
 
-// TODO: Need Explanation!!!!!!!!!!!!1
 void UAbilityTask_WaitSpawnEnemies::OnGameplayEventReceived(const FGameplayEventData* InPayload)
 {
-	if (ensure(!CachedSoftEnemyClassToSpawn.IsNull()))
+	if (bSpawnRequested)
 	{
-		UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(CachedSoftEnemyClassToSpawn.ToSoftObjectPath(),
-			FStreamableDelegate::CreateUObject(this, &UAbilityTask_WaitSpawnEnemies::OnEnemyClassLoaded));
+		return;
 	}
-	else
+
+	if (!ensure(!CachedSoftEnemyClassToSpawn.IsNull()) || !GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>())
 	{
 		if (ShouldBroadcastAbilityTaskDelegates())
 		{
@@ -55,54 +59,88 @@ void UAbilityTask_WaitSpawnEnemies::OnGameplayEventReceived(const FGameplayEvent
 		}
 
 		EndTask();
+
+		return;
+	}
+
+	bSpawnRequested = true;
+
+	// 类别仍在加载时由 OnEnemyClassLoaded 继续
+	if (bEnemyClassLoadFinished)
+	{
+		EnqueueEnemySummons();
 	}
-	
 }
 
 void UAbilityTask_WaitSpawnEnemies::OnEnemyClassLoaded()
 {
-	UClass* LoadedClass = CachedSoftEnemyClassToSpawn.Get();
-	UWorld* World = GetWorld();
+	bEnemyClassLoadFinished = true;
+
+	CachedLoadedEnemyClass = CachedSoftEnemyClassToSpawn.Get();
+
+	UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>();
 
-	if (!LoadedClass || !World)
+	if (CachedLoadedEnemyClass && EnemyPoolSubsystem)
 	{
-		if (ShouldBroadcastAbilityTaskDelegates())
-		{
-			DidNotSpawn.Broadcast(TArray<AWarriorEnemyCharacter*>());
-		}
+		EnemyPoolSubsystem->QueuePrewarmEnemies(CachedSoftEnemyClassToSpawn, CachedLoadedEnemyClass, CachedNumToSpawn);
+	}
 
-		EndTask();
+	if (bSpawnRequested)
+	{
+		EnqueueEnemySummons();
+	}
+}
+
+void UAbilityTask_WaitSpawnEnemies::EnqueueEnemySummons()
+{
+	UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>();
 
+	if (!CachedLoadedEnemyClass || !EnemyPoolSubsystem || CachedNumToSpawn <= 0)
+	{
+		FinishSpawnEnemies();
 		return;
 	}
 
-	TArray<AWarriorEnemyCharacter*> SpawnedEnemies;
+	const FRotator SpawnFacingRotation = AbilitySystemComponent->GetAvatarActor()->GetActorForwardVector().ToOrientationRotator();
 
-	FActorSpawnParameters SpawnParam;
-	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	NumPendingSummons = CachedNumToSpawn;
 
 	for (int32 i = 0; i < CachedNumToSpawn; i++)
 	{
-		FVector RandomLocation;
-		UNavigationSystemV1::K2_GetRandomReachablePointInRadius(this, CachedSpawnOrigin, RandomLocation, CachedRandomSpawnRadius);
-
-		RandomLocation += FVector(0.f, 0.f, 150.f);
+		FWarriorEnemySummonRequest SummonRequest;
+		SummonRequest.SoftEnemyClass = CachedSoftEnemyClassToSpawn;
+		SummonRequest.LoadedEnemyClass = CachedLoadedEnemyClass;
+		SummonRequest.SpawnOrigin = CachedSpawnOrigin;
+		SummonRequest.RandomSpawnRadius = CachedRandomSpawnRadius;
+		SummonRequest.SpawnRotation = SpawnFacingRotation;
+		SummonRequest.OnEnemySummoned.BindUObject(this, &ThisClass::OnEnemySummoned);
+
+		EnemyPoolSubsystem->EnqueueSummon(MoveTemp(SummonRequest));
+	}
+}
 
-		const FRotator SpawnFacingRotation = AbilitySystemComponent->GetAvatarActor()->GetActorForwardVector().ToOrientationRotator();
+void UAbilityTask_WaitSpawnEnemies::OnEnemySummoned(AWarriorEnemyCharacter* InSummonedEnemy)
+{
+	if (InSummonedEnemy)
+	{
+		SummonedEnemies.Add(InSummonedEnemy);
+	}
 
-		AWarriorEnemyCharacter* SpawnedEnemy = World->SpawnActor<AWarriorEnemyCharacter>(LoadedClass, RandomLocation, SpawnFacingRotation, SpawnParam);
+	NumPendingSummons--;
 
-		if (SpawnedEnemy)
-		{
-			SpawnedEnemies.Add(SpawnedEnemy);
-		}
+	if (NumPendingSummons <= 0)
+	{
+		FinishSpawnEnemies();
 	}
+}
 
+void UAbilityTask_WaitSpawnEnemies::FinishSpawnEnemies()
+{
 	if (ShouldBroadcastAbilityTaskDelegates())
 	{
-		if (!SpawnedEnemies.IsEmpty())
+		if (!SummonedEnemies.IsEmpty())
 		{
-			OnSpawnFinished.Broadcast(SpawnedEnemies);
+			OnSpawnFinished.Broadcast(SummonedEnemies);
 		}
 		else
 		{
@@ -111,5 +149,4 @@ void UAbilityTask_WaitSpawnEnemies::OnEnemyClassLoaded()
 	}
 
 	EndTask();
-	
 }
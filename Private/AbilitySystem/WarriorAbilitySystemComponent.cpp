@@ -5,6 +5,7 @@
 
 #include "WarriorGameplayTags.h"
 #include "AbilitySystem/Abilities/WarriorHeroGameplayAbility.h"
+#include "Subsystems/WarriorRandomSubsystem.h"
 
 /**
  * @brief 处理能力输入按下的函数
@@ -235,7 +236,7 @@ bool UWarriorAbilitySystemComponent::TryActivateAbilityByTag(FGameplayTag Abilit
 
 	if (!FoundAbilitySpecs.IsEmpty())
 	{
-		const int32 RandomAbilityIndex = FMath::RandRange(0, FoundAbilitySpecs.Num() - 1);
+		const int32 RandomAbilityIndex = UWarriorRandomSubsystem::RandRange(this, EWarriorRandomStream::AbilityChoice, 0, FoundAbilitySpecs.Num() - 1);
 		FGameplayAbilitySpec* SpecToActivate = FoundAbilitySpecs[RandomAbilityIndex];
 
 		check(SpecToActivate);
@@ -251,3 +252,19 @@ bool UWarriorAbilitySystemComponent::TryActivateAbilityByTag(FGameplayTag Abilit
 
 	
 }
+
+void UWarriorAbilitySystemComponent::ResetAbilitySystemForReuse()
+{
+	CancelAllAbilities();
+	ClearAllAbilities();
+
+	RemoveActiveEffects(FGameplayEffectQuery());
+
+	FGameplayTagContainer OwnedTags;
+	GetOwnedGameplayTags(OwnedTags);
+
+	for (const FGameplayTag& OwnedTag : OwnedTags)
+	{
+		SetLooseGameplayTagCount(OwnedTag, 0);
+	}
+}
@@ -53,6 +53,19 @@ UWarriorAttributeSet::UWarriorAttributeSet()
 	InitDamageTaken(0.f);
 }
 
+void UWarriorAttributeSet::ResetAttributesToDefaults()
+{
+	const UWarriorAttributeSet* DefaultAttributeSet = GetDefault<UWarriorAttributeSet>();
+
+	InitCurrentHealth(DefaultAttributeSet->GetCurrentHealth());
+	InitMaxHealth(DefaultAttributeSet->GetMaxHealth());
+	InitCurrentRage(DefaultAttributeSet->GetCurrentRage());
+	InitMaxRage(DefaultAttributeSet->GetMaxRage());
+	InitAttackPower(DefaultAttributeSet->GetAttackPower());
+	InitDefensePower(DefaultAttributeSet->GetDefensePower());
+	InitDamageTaken(DefaultAttributeSet->GetDamageTaken());
+}
+
 /**
  * @brief 游戏效果执行后的回调函数
  * 
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AnimInstances/Notifies/AnimNotifyState_EnemyHandSweep.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "WarriorFunctionLibrary.h"
+
+void UAnimNotifyState_EnemyHandSweep::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
+	float TotalDuration, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
+
+	// 动画编辑器预览中没有战斗组件，此时什么也不做
+	if (!MeshComp->GetOwner())
+	{
+		return;
+	}
+
+	if (UPawnCombatComponent* PawnCombatComponent = UWarriorFunctionLibrary::NativeGetPawnCombatComponentFromActor(MeshComp->GetOwner()))
+	{
+		PawnCombatComponent->ToggleWeaponCollision(true, HandToSweep);
+	}
+}
+
+void UAnimNotifyState_EnemyHandSweep::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
+	const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+
+	if (!MeshComp->GetOwner())
+	{
+		return;
+	}
+
+	if (UPawnCombatComponent* PawnCombatComponent = UWarriorFunctionLibrary::NativeGetPawnCombatComponentFromActor(MeshComp->GetOwner()))
+	{
+		PawnCombatComponent->ToggleWeaponCollision(false, HandToSweep);
+	}
+}
+
+FString UAnimNotifyState_EnemyHandSweep::GetNotifyName_Implementation() const
+{
+	return HandToSweep == EToggleDamageType::LeftHand ? TEXT("Left Hand Sweep") : TEXT("Right Hand Sweep");
+}
@@ -15,7 +15,8 @@
  * 3. 创建并初始化能力系统组件
  * 4. 创建并初始化属性集组件
  */
-AWarriorBaseCharacter::AWarriorBaseCharacter()
+AWarriorBaseCharacter::AWarriorBaseCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
  	// 禁用角色的Tick功能以提高性能
 	// 对于不需要每帧更新的角色，禁用Tick可以提升游戏性能
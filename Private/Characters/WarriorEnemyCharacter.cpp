@@ -10,6 +10,31 @@
 #include "WarriorFunctionLibrary.h"
 #include "GameModes/WarriorBaseGameMode.h"
 #include "Widgets/WarriorWidgetBase.h"
+#include "Widgets/WarriorEnemyHealthBarLayerWidget.h"
+#include "AIController.h"
+#include "Controllers/WarriorAIController.h"
+#include "WarriorGameplayTags.h"
+#include "Animation/AnimInstance.h"
+#include "BrainComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/WarriorBehaviorTreeComponent.h"
+#include "Components/WarriorBudgetedSkeletalMeshComponent.h"
+#include "Subsystems/WarriorEnemyPoolSubsystem.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "WarriorStats.h"
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Enemy Possess To Ready (ms)"), STAT_WarriorEnemyPossessToReadyMs, STATGROUP_WarriorSurvival);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Max Enemy Possess To Ready (ms)"), STAT_WarriorMaxEnemyPossessToReadyMs, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Ready"), STAT_WarriorEnemiesReady, STATGROUP_WarriorSurvival);
+DECLARE_CYCLE_STAT(TEXT("Wake Enemy From Dormancy"), STAT_WarriorWakeEnemyFromDormancy, STATGROUP_WarriorSurvival);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Enemy Wake Up (ms)"), STAT_WarriorEnemyWakeUpMs, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemy Wake Ups"), STAT_WarriorEnemyWakeUps, STATGROUP_WarriorSurvival);
+
+// 当前世界中所有敌人从占有到启动数据应用完成的最长耗时，换到新的世界（例如再次进入PIE）时重新统计
+static float MaxEnemyPossessToReadyMs = 0.f;
+static TWeakObjectPtr<const UWorld> MaxEnemyPossessToReadyWorld;
 
 /**
  * @brief 构造函数实现
@@ -23,7 +48,8 @@
  * 2. 配置角色移动参数，使角色能够自动面向移动方向
  * 3. 创建并初始化敌人战斗组件
  */
-AWarriorEnemyCharacter::AWarriorEnemyCharacter()
+AWarriorEnemyCharacter::AWarriorEnemyCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UWarriorBudgetedSkeletalMeshComponent>(ACharacter::MeshComponentName))
 {
 	// 设置角色自动被AI控制器控制
 	// PlacedInWorldOrSpawned表示在世界中放置或生成时自动被AI控制
@@ -59,17 +85,6 @@ AWarriorEnemyCharacter::AWarriorEnemyCharacter()
 	EnemyHealthWidgetComponent = CreateDefaultSubobject<UWidgetComponent>("EnemyHealthWidgetComponent");
 	EnemyHealthWidgetComponent->SetupAttachment(GetMesh());
 
-	LeftHandCollisionBox = CreateDefaultSubobject<UBoxComponent>("LeftHandCollisionBox");
-	LeftHandCollisionBox->SetupAttachment(GetMesh());
-	LeftHandCollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	LeftHandCollisionBox->OnComponentBeginOverlap.AddUniqueDynamic(this, &ThisClass::OnBodyCollisionBoxBeginOverlap);
-	
-	RightHandCollisionBox = CreateDefaultSubobject<UBoxComponent>("RightHandCollisionBox");
-	RightHandCollisionBox->SetupAttachment(GetMesh());
-	RightHandCollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	RightHandCollisionBox->OnComponentBeginOverlap.AddUniqueDynamic(this, &ThisClass::OnBodyCollisionBoxBeginOverlap);
-
-	
 }
 
 /**
@@ -93,23 +108,6 @@ void AWarriorEnemyCharacter::PossessedBy(AController* NewController)
 	InitEnemyStartUpData();
 }
 
-#if WITH_EDITOR
-void AWarriorEnemyCharacter::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
-{
-	Super::PostEditChangeProperty(PropertyChangedEvent);
-
-	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, LeftHandCollisionAttachmentBoneName))
-	{
-		LeftHandCollisionBox->AttachToComponent(GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, LeftHandCollisionAttachmentBoneName);
-	}
-
-	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, RightHandCollisionAttachmentBoneName))
-	{
-		RightHandCollisionBox->AttachToComponent(GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, RightHandCollisionAttachmentBoneName);
-	}
-}
-#endif
-
 /**
  * @brief 获取角色战斗组件实现
  * 
@@ -135,28 +133,361 @@ UEnemyUIComponent* AWarriorEnemyCharacter::GetEnemyUIComponent() const
 	return EnemyUIComponent;
 }
 
+void AWarriorEnemyCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// 血条由玩家控制器创建的血条层统一绘制时，清空控件类，组件开始游戏时就不会为每个敌人创建用户控件
+	if (GetWorld() && GetWorld()->IsGameWorld() && UWarriorEnemyHealthBarLayerWidget::IsBatchedHealthBarEnabled())
+	{
+		EnemyHealthWidgetComponent->SetWidgetClass(nullptr);
+		EnemyHealthWidgetComponent->SetVisibility(false);
+	}
+}
+
 void AWarriorEnemyCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// 血条由血条层统一绘制时不会创建用户控件，这里直接跳过初始化
 	if (UWarriorWidgetBase* HealthWidget = Cast<UWarriorWidgetBase>(EnemyHealthWidgetComponent->GetUserWidgetObject()))
 	{
 		HealthWidget->InitEnemyCreatedWidget(this);
 	}
+	else
+	{
+		EnemyHealthWidgetComponent->SetComponentTickEnabled(false);
+	}
 
-	
+	WarriorAbilitySystemComponent->GenericGameplayEventCallbacks.FindOrAdd(WarriorGameplayTags::Shared_Event_HitReact)
+		.AddUObject(this, &ThisClass::OnHitReactEventReceived);
+
+	LastWakeTime = GetWorld()->GetTimeSeconds();
+
+	// 网格体注册组件时分配器可能尚未由重要度子系统启用，开始游戏时再注册一次
+	if (UWarriorBudgetedSkeletalMeshComponent* BudgetedMesh = Cast<UWarriorBudgetedSkeletalMeshComponent>(GetMesh()))
+	{
+		BudgetedMesh->SetRegisteredWithAnimationBudget(true);
+	}
+
+	if (UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>())
+	{
+		EnemyRegistrySubsystem->RegisterEnemy(this);
+	}
+}
+
+void AWarriorEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>())
+	{
+		EnemyRegistrySubsystem->UnregisterEnemy(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AWarriorEnemyCharacter::Destroyed()
+{
+	// 兼容仍直接销毁敌人的旧死亡流程
+	BroadcastDeathFinished();
+
+	Super::Destroyed();
+}
+
+void AWarriorEnemyCharacter::FinishDeath()
+{
+	BroadcastDeathFinished();
+
+	if (UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>())
+	{
+		if (EnemyPoolSubsystem->ReleaseEnemy(this))
+		{
+			return;
+		}
+	}
+
+	Destroy();
+}
+
+void AWarriorEnemyCharacter::OnAcquiredFromPool(const FVector& InLocation, const FRotator& InRotation)
+{
+	bHasBroadcastDeathFinished = false;
+	LastWakeTime = GetWorld()->GetTimeSeconds();
+
+	// 回收期间各组件的设置已被改动，由重要度子系统在下一次分级时重新应用
+	CurrentSignificanceTier = EWarriorEnemySignificanceTier::MAX;
+
+	SetActorLocationAndRotation(InLocation, InRotation, false, nullptr, ETeleportType::ResetPhysics);
+
+	const AWarriorEnemyCharacter* EnemyCDO = GetClass()->GetDefaultObject<AWarriorEnemyCharacter>();
+	GetCapsuleComponent()->SetCollisionEnabled(EnemyCDO->GetCapsuleComponent()->GetCollisionEnabled());
+	GetMesh()->SetCollisionEnabled(EnemyCDO->GetMesh()->GetCollisionEnabled());
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	GetMesh()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	if (UWarriorBudgetedSkeletalMeshComponent* BudgetedMesh = Cast<UWarriorBudgetedSkeletalMeshComponent>(GetMesh()))
+	{
+		BudgetedMesh->SetRegisteredWithAnimationBudget(true);
+	}
+
+	EnemyHealthWidgetComponent->SetVisibility(!UWarriorEnemyHealthBarLayerWidget::IsBatchedHealthBarEnabled());
+	EnemyHealthWidgetComponent->SetComponentTickEnabled(!UWarriorEnemyHealthBarLayerWidget::IsBatchedHealthBarEnabled());
+
+	// 重新占有会触发PossessedBy，进而重新初始化ASC并应用启动数据
+	if (PooledAIController)
+	{
+		PooledAIController->Possess(this);
+	}
+	else
+	{
+		SpawnDefaultController();
+	}
+
+	EnemyUIComponent->OnCurrentHealthChanged.Broadcast(1.f);
+
+	// 占有之后再登记，登记表才能读到控制器的阵营
+	if (UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>())
+	{
+		EnemyRegistrySubsystem->RegisterEnemy(this);
+	}
+
+	BP_OnAcquiredFromPool();
 }
 
-void AWarriorEnemyCharacter::OnBodyCollisionBoxBeginOverlap(UPrimitiveComponent* OverlappedComponent,
-	AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep,
-	const FHitResult& SweepResult)
+void AWarriorEnemyCharacter::OnReleasedToPool()
 {
-	if (APawn* HitPawn = Cast<APawn>(OtherActor))
+	// 先恢复控制器的休眠状态，下面再统一停止AI
+	WakeFromDormancy();
+
+	if (UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>())
 	{
-		if (UWarriorFunctionLibrary::IsTargetPawnHostile(this, HitPawn))
+		EnemyRegistrySubsystem->UnregisterEnemy(this);
+	}
+
+	if (AAIController* AIController = GetController<AAIController>())
+	{
+		if (UBrainComponent* BrainComponent = AIController->GetBrainComponent())
 		{
-			EnemyCombatComponent->OnHitTargetActor(HitPawn);
+			BrainComponent->StopLogic(TEXT("Released To Enemy Pool"));
 		}
+
+		AIController->StopMovement();
+		AIController->UnPossess();
+
+		PooledAIController = AIController;
+	}
+
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->StopAllMontages(0.f);
+	}
+
+	WarriorAbilitySystemComponent->ResetAbilitySystemForReuse();
+	WarriorAttributeSet->ResetAttributesToDefaults();
+	PendingHealthPercent = 1.f;
+	bHasAppliedStartUpData = false;
+	EnemyCombatComponent->ResetCombatState();
+	EnemyUIComponent->RemoveEnemyDrawnWidgetIfAny();
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+
+	// 先从动画预算分配器注销，否则分配器会重新打开网格体的更新
+	if (UWarriorBudgetedSkeletalMeshComponent* BudgetedMesh = Cast<UWarriorBudgetedSkeletalMeshComponent>(GetMesh()))
+	{
+		BudgetedMesh->SetRegisteredWithAnimationBudget(false);
+	}
+
+	GetMesh()->SetComponentTickEnabled(false);
+
+	EnemyHealthWidgetComponent->SetVisibility(false);
+	EnemyHealthWidgetComponent->SetComponentTickEnabled(false);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+}
+
+void AWarriorEnemyCharacter::ApplySignificanceTier(EWarriorEnemySignificanceTier InTier, const FWarriorSignificanceTierSettings& InTierSettings)
+{
+	// 休眠期间由休眠状态决定各组件的更新，醒来后再重新应用级别
+	if (CurrentSignificanceTier == InTier || bIsDormant)
+	{
+		return;
+	}
+
+	CurrentSignificanceTier = InTier;
+
+	GetCharacterMovement()->SetComponentTickInterval(InTierSettings.MovementTickInterval);
+
+	// 网格体由动画预算分配器管理时，动画的更新频率交给分配器决定
+	const UWarriorBudgetedSkeletalMeshComponent* BudgetedMesh = Cast<UWarriorBudgetedSkeletalMeshComponent>(GetMesh());
+
+	if (!BudgetedMesh || !BudgetedMesh->IsManagedByAnimationBudget())
+	{
+		GetMesh()->SetComponentTickInterval(InTierSettings.AnimationTickInterval);
+		GetMesh()->bEnableUpdateRateOptimizations = InTierSettings.bEnableUpdateRateOptimizations;
+		GetMesh()->VisibilityBasedAnimTickOption = InTierSettings.VisibilityBasedAnimTickOption;
+	}
+
+	const bool bShowHealthWidget = InTierSettings.bShowHealthWidget && !UWarriorEnemyHealthBarLayerWidget::IsBatchedHealthBarEnabled();
+
+	EnemyHealthWidgetComponent->SetVisibility(bShowHealthWidget);
+	EnemyHealthWidgetComponent->SetComponentTickEnabled(bShowHealthWidget);
+
+	AAIController* AIController = GetController<AAIController>();
+
+	if (!AIController)
+	{
+		return;
+	}
+
+	// 行为树每次更新后都会重新安排自己的 Tick 间隔，直接设置会被覆盖，需要交给行为树组件在安排时作为下限
+	if (UWarriorBehaviorTreeComponent* BehaviorTreeComponent = Cast<UWarriorBehaviorTreeComponent>(AIController->GetBrainComponent()))
+	{
+		BehaviorTreeComponent->SetTierTickInterval(InTierSettings.BehaviorTreeTickInterval);
+	}
+	else if (UBrainComponent* BrainComponent = AIController->GetBrainComponent())
+	{
+		BrainComponent->SetComponentTickInterval(InTierSettings.BehaviorTreeTickInterval);
+	}
+
+	if (UPathFollowingComponent* PathFollowingComponent = AIController->GetPathFollowingComponent())
+	{
+		PathFollowingComponent->SetComponentTickInterval(InTierSettings.CrowdFollowingTickInterval);
+	}
+
+	if (UAIPerceptionComponent* PerceptionComponent = AIController->GetAIPerceptionComponent())
+	{
+		PerceptionComponent->SetComponentTickInterval(InTierSettings.PerceptionTickInterval);
+	}
+
+	if (AWarriorAIController* WarriorAIController = Cast<AWarriorAIController>(AIController))
+	{
+		WarriorAIController->SetSightPerceptionAllowed(InTierSettings.bEnableSightPerception);
+	}
+}
+
+void AWarriorEnemyCharacter::InvalidateSignificanceTier()
+{
+	CurrentSignificanceTier = EWarriorEnemySignificanceTier::MAX;
+}
+
+void AWarriorEnemyCharacter::SetPendingHealthPercent(float InHealthPercent)
+{
+	PendingHealthPercent = FMath::Clamp(InHealthPercent, KINDA_SMALL_NUMBER, 1.f);
+
+	// 启动数据已经加载时占有过程会同步应用启动数据，此时直接恢复血量
+	if (bHasAppliedStartUpData)
+	{
+		ApplyPendingHealthPercent();
+	}
+}
+
+void AWarriorEnemyCharacter::ApplyPendingHealthPercent()
+{
+	if (PendingHealthPercent >= 1.f)
+	{
+		return;
+	}
+
+	WarriorAbilitySystemComponent->SetNumericAttributeBase(UWarriorAttributeSet::GetCurrentHealthAttribute(),
+		WarriorAttributeSet->GetMaxHealth() * PendingHealthPercent);
+
+	EnemyUIComponent->OnCurrentHealthChanged.Broadcast(PendingHealthPercent);
+
+	PendingHealthPercent = 1.f;
+}
+
+void AWarriorEnemyCharacter::EnterDormancy()
+{
+	if (bIsDormant)
+	{
+		return;
+	}
+
+	bIsDormant = true;
+
+	if (AWarriorAIController* WarriorAIController = GetController<AWarriorAIController>())
+	{
+		WarriorAIController->EnterDormancy();
+	}
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+
+	GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+
+	// 血条保持当前显示状态，只是不再更新
+	EnemyHealthWidgetComponent->SetComponentTickEnabled(false);
+}
+
+void AWarriorEnemyCharacter::WakeFromDormancy()
+{
+	if (!bIsDormant)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorWakeEnemyFromDormancy);
+
+	const double WakeStartTimeSeconds = FPlatformTime::Seconds();
+
+	bIsDormant = false;
+	LastWakeTime = GetWorld()->GetTimeSeconds();
+
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+
+	GetMesh()->VisibilityBasedAnimTickOption = GetClass()->GetDefaultObject<AWarriorEnemyCharacter>()->GetMesh()->VisibilityBasedAnimTickOption;
+
+	EnemyHealthWidgetComponent->SetComponentTickEnabled(EnemyHealthWidgetComponent->IsVisible());
+
+	if (AWarriorAIController* WarriorAIController = GetController<AWarriorAIController>())
+	{
+		WarriorAIController->ExitDormancy();
+	}
+
+	// 由重要度子系统在下一次分级时重新应用各组件的更新频率
+	CurrentSignificanceTier = EWarriorEnemySignificanceTier::MAX;
+
+	SET_FLOAT_STAT(STAT_WarriorEnemyWakeUpMs, static_cast<float>((FPlatformTime::Seconds() - WakeStartTimeSeconds) * 1000.0));
+	INC_DWORD_STAT(STAT_WarriorEnemyWakeUps);
+}
+
+void AWarriorEnemyCharacter::OnHitReactEventReceived(const FGameplayEventData* InPayload)
+{
+	WakeFromDormancy();
+}
+
+void AWarriorEnemyCharacter::BroadcastDeathFinished()
+{
+	if (bHasBroadcastDeathFinished)
+	{
+		return;
+	}
+
+	bHasBroadcastDeathFinished = true;
+
+	OnEnemyDeathFinished.Broadcast(this);
+}
+
+FName AWarriorEnemyCharacter::GetHandSweepBoneName(EToggleDamageType InHandType) const
+{
+	switch (InHandType)
+	{
+	case EToggleDamageType::LeftHand:
+		return LeftHandCollisionAttachmentBoneName;
+
+	case EToggleDamageType::RightHand:
+		return RightHandCollisionAttachmentBoneName;
+
+	default:
+		return NAME_None;
 	}
 }
 
@@ -200,6 +531,16 @@ void AWarriorEnemyCharacter::InitEnemyStartUpData()
 		}	
 	}
 
+	// 从占有开始计时，到启动数据应用完成为止
+	PossessedTimeSeconds = FPlatformTime::Seconds();
+
+	// 数据资产已经加载（例如对象池中复用的敌人）时直接应用，无需再走一次异步加载
+	if (CharacterStartUpData.Get())
+	{
+		ApplyEnemyStartUpData(AbilityApplyLevel);
+		return;
+	}
+
 	// 使用Unreal的资源管理器异步加载 CharacterStartUpData 指定的资源（通常是 DataAsset）
 	// 异步加载避免阻塞游戏主线程，提高性能
 	UAssetManager::GetStreamableManager().RequestAsyncLoad(
@@ -207,21 +548,45 @@ void AWarriorEnemyCharacter::InitEnemyStartUpData()
 		CharacterStartUpData.ToSoftObjectPath(),
 		
 		// 创建一个异步加载完成时的 Lambda 回调函数，等资源加载完成后自动调用
-		FStreamableDelegate::CreateLambda(
+		FStreamableDelegate::CreateWeakLambda(this,
 			[this, AbilityApplyLevel]()
 			{
-				// 在异步加载完成后，获取并使用实际的数据资产对象指针并调用数据资产方法
-				// 如果没有获取到数据资产对象指针，则说明加载失败或数据资产未设置
-				if (UDataAsset_StartUpDataBase* LoadedData = CharacterStartUpData.Get())
-				{
-					// 调用数据资产的方法，把能力（如技能、属性等）赋予当前角色的能力系统组件
-					// GiveToAbilitySystemComponent是数据资产中的方法，用于初始化角色的能力系统
-					LoadedData -> GiveToAbilitySystemComponent(WarriorAbilitySystemComponent, AbilityApplyLevel);
-
-					// Debug
-					// Debug::Print(TEXT("Enemy StartUpData loaded and applied successfully!"), FColor::Green, 5.0f);
-				}
+				ApplyEnemyStartUpData(AbilityApplyLevel);
 			}
 		)
 	);
+}
+
+void AWarriorEnemyCharacter::ApplyEnemyStartUpData(int32 AbilityApplyLevel)
+{
+	// 获取并使用实际的数据资产对象指针并调用数据资产方法
+	// 如果没有获取到数据资产对象指针，则说明加载失败或数据资产未设置
+	UDataAsset_StartUpDataBase* LoadedData = CharacterStartUpData.Get();
+
+	if (!LoadedData)
+	{
+		return;
+	}
+
+	// 调用数据资产的方法，把能力（如技能、属性等）赋予当前角色的能力系统组件
+	LoadedData->GiveToAbilitySystemComponent(WarriorAbilitySystemComponent, AbilityApplyLevel);
+
+	bHasAppliedStartUpData = true;
+
+	// 启动效果会把血量初始化为满值，由群体实体提升而来的敌人在此恢复原有血量
+	ApplyPendingHealthPercent();
+
+	const float PossessToReadyMs = static_cast<float>((FPlatformTime::Seconds() - PossessedTimeSeconds) * 1000.0);
+
+	if (MaxEnemyPossessToReadyWorld.Get() != GetWorld())
+	{
+		MaxEnemyPossessToReadyWorld = GetWorld();
+		MaxEnemyPossessToReadyMs = 0.f;
+	}
+
+	MaxEnemyPossessToReadyMs = FMath::Max(MaxEnemyPossessToReadyMs, PossessToReadyMs);
+
+	SET_FLOAT_STAT(STAT_WarriorEnemyPossessToReadyMs, PossessToReadyMs);
+	SET_FLOAT_STAT(STAT_WarriorMaxEnemyPossessToReadyMs, MaxEnemyPossessToReadyMs);
+	INC_DWORD_STAT(STAT_WarriorEnemiesReady);
 }
\ No newline at end of file
@@ -7,6 +7,25 @@
 #include "WarriorDebugHelper.h"
 #include "WarriorFunctionLibrary.h"
 #include "WarriorGameplayTags.h"
+#include "DrawDebugHelpers.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Hand Sweep"), STAT_WarriorEnemyHandSweep, STATGROUP_WarriorSurvival);
+
+UEnemyCombatComponent::UEnemyCombatComponent()
+{
+	// 只在攻击判定窗口打开时更新，动画更新之后再读取骨骼位置
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UEnemyCombatComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	SweepActiveHands();
+}
 
 void UEnemyCombatComponent::OnHitTargetActor(AActor* HitActor)
 {
@@ -47,33 +66,129 @@ void UEnemyCombatComponent::OnHitTargetActor(AActor* HitActor)
 	
 }
 
+void UEnemyCombatComponent::ResetCombatState()
+{
+	Super::ResetCombatState();
+
+	ActiveHandSweeps.Reset();
+	SetComponentTickEnabled(false);
+}
+
 void UEnemyCombatComponent::ToggleBodyCollisionBoxCollision(bool bShouldEnable, EToggleDamageType ToggleDamageType)
 {
 	AWarriorEnemyCharacter* OwningEnemyCharacter = GetOwningPawn<AWarriorEnemyCharacter>();
 
 	check(OwningEnemyCharacter);
 
-	UBoxComponent* LeftHandCollisionBox = OwningEnemyCharacter->GetLeftHandCollisionBox();
-	UBoxComponent* RightHandCollisionBox = OwningEnemyCharacter->GetRightHandCollisionBox();
+	const int32 ActiveHandIndex = ActiveHandSweeps.IndexOfByPredicate([ToggleDamageType](const FActiveHandSweep& HandSweep)
+	{
+		return HandSweep.HandType == ToggleDamageType;
+	});
 
-	check(LeftHandCollisionBox && RightHandCollisionBox);
+	if (bShouldEnable)
+	{
+		const FName BoneName = OwningEnemyCharacter->GetHandSweepBoneName(ToggleDamageType);
+		const USkeletalMeshComponent* Mesh = OwningEnemyCharacter->GetMesh();
 
-	switch (ToggleDamageType)
+		if (ActiveHandIndex == INDEX_NONE && BoneName != NAME_None && Mesh->GetBoneIndex(BoneName) != INDEX_NONE)
+		{
+			// 以窗口开启时的手部位置作为第一次扫掠的起点
+			FActiveHandSweep& HandSweep = ActiveHandSweeps.AddDefaulted_GetRef();
+			HandSweep.HandType = ToggleDamageType;
+			HandSweep.BoneName = BoneName;
+			HandSweep.PreviousBoneComponentTransform = Mesh->GetSocketTransform(BoneName, RTS_Component);
+			HandSweep.PreviousComponentToWorld = Mesh->GetComponentTransform();
+		}
+	}
+	else
 	{
-	case EToggleDamageType::LeftHand:
-		LeftHandCollisionBox->SetCollisionEnabled(bShouldEnable ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
-		break;
-		
-	case EToggleDamageType::RightHand:
-		RightHandCollisionBox->SetCollisionEnabled(bShouldEnable ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
-		break;
-		
-	default:
-		break;
+		if (ActiveHandIndex != INDEX_NONE)
+		{
+			// 关闭前补上最后一段扫掠，避免窗口末尾的一帧挥击被漏掉
+			SweepActiveHands();
+
+			ActiveHandSweeps.RemoveAtSwap(ActiveHandIndex);
+		}
+
+		OverlappedActors.Empty();
 	}
 
-	if (!bShouldEnable)
+	SetComponentTickEnabled(!ActiveHandSweeps.IsEmpty());
+}
+
+void UEnemyCombatComponent::SweepActiveHands()
+{
+	if (ActiveHandSweeps.IsEmpty())
 	{
-		OverlappedActors.Empty();
+		return;
 	}
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorEnemyHandSweep);
+
+	AWarriorEnemyCharacter* OwningEnemyCharacter = GetOwningPawn<AWarriorEnemyCharacter>();
+	const USkeletalMeshComponent* Mesh = OwningEnemyCharacter->GetMesh();
+	const UWorld* World = GetWorld();
+
+	const FTransform ComponentToWorld = Mesh->GetComponentTransform();
+	const FCollisionShape SweepShape = FCollisionShape::MakeSphere(HandSweepRadius);
+	const FCollisionObjectQueryParams ObjectQueryParams(ECC_Pawn);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(EnemyHandSweep), false, OwningEnemyCharacter);
+
+	for (FActiveHandSweep& HandSweep : ActiveHandSweeps)
+	{
+		const FTransform BoneComponentTransform = Mesh->GetSocketTransform(HandSweep.BoneName, RTS_Component);
+
+		const FVector PreviousLocation = HandSweep.PreviousComponentToWorld.TransformPosition(HandSweep.PreviousBoneComponentTransform.GetLocation());
+		const FVector CurrentLocation = ComponentToWorld.TransformPosition(BoneComponentTransform.GetLocation());
+
+		const int32 NumSubSteps = FMath::Clamp(
+			FMath::CeilToInt(FVector::Dist(PreviousLocation, CurrentLocation) / FMath::Max(MaxHandSweepSubStepDistance, 1.f)),
+			1, FMath::Max(MaxHandSweepSubSteps, 1));
+
+		FVector SubStepStart = PreviousLocation;
+
+		for (int32 SubStepIndex = 1; SubStepIndex <= NumSubSteps; SubStepIndex++)
+		{
+			const FVector SubStepEnd = SubStepIndex == NumSubSteps ? CurrentLocation
+				: InterpolateHandLocation(HandSweep, BoneComponentTransform, ComponentToWorld, static_cast<float>(SubStepIndex) / NumSubSteps);
+
+			HandSweepHitResults.Reset();
+
+			World->SweepMultiByObjectType(HandSweepHitResults, SubStepStart, SubStepEnd, FQuat::Identity, ObjectQueryParams, SweepShape, QueryParams);
+
+			for (const FHitResult& HitResult : HandSweepHitResults)
+			{
+				APawn* HitPawn = Cast<APawn>(HitResult.GetActor());
+
+				if (HitPawn && UWarriorFunctionLibrary::IsTargetPawnHostile(OwningEnemyCharacter, HitPawn))
+				{
+					OnHitTargetActor(HitPawn);
+				}
+			}
+
+			if (bDrawDebugHandSweep)
+			{
+				DrawDebugCapsule(World, (SubStepStart + SubStepEnd) * 0.5f, FVector::Dist(SubStepStart, SubStepEnd) * 0.5f + HandSweepRadius,
+					HandSweepRadius, FRotationMatrix::MakeFromZ(SubStepEnd - SubStepStart).ToQuat(),
+					HandSweepHitResults.IsEmpty() ? FColor::Green : FColor::Red, false, 1.f);
+			}
+
+			SubStepStart = SubStepEnd;
+		}
+
+		HandSweep.PreviousBoneComponentTransform = BoneComponentTransform;
+		HandSweep.PreviousComponentToWorld = ComponentToWorld;
+	}
+}
+
+FVector UEnemyCombatComponent::InterpolateHandLocation(const FActiveHandSweep& InHandSweep, const FTransform& InBoneComponentTransform,
+	const FTransform& InComponentToWorld, float InAlpha)
+{
+	FTransform BlendedComponentToWorld;
+	BlendedComponentToWorld.Blend(InHandSweep.PreviousComponentToWorld, InComponentToWorld, InAlpha);
+
+	const FVector BlendedBoneLocation = FMath::Lerp(InHandSweep.PreviousBoneComponentTransform.GetLocation(), InBoneComponentTransform.GetLocation(), InAlpha);
+
+	return BlendedComponentToWorld.TransformPosition(BlendedBoneLocation);
 }
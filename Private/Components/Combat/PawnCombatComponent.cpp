@@ -186,6 +186,21 @@ void UPawnCombatComponent::OnWeaponPulledFromTarget(AActor* InteractedActor)
 	// }
 }
 
+void UPawnCombatComponent::ResetCombatState()
+{
+	for (const TPair<FGameplayTag, AWarriorWeaponBase*>& CarriedWeaponPair : CharacterCarriedWeaponMap)
+	{
+		if (IsValid(CarriedWeaponPair.Value))
+		{
+			CarriedWeaponPair.Value->Destroy();
+		}
+	}
+
+	CharacterCarriedWeaponMap.Empty();
+	CurrentEquippedWeaponTag = FGameplayTag();
+	OverlappedActors.Empty();
+}
+
 void UPawnCombatComponent::ToggleCurrentEquippedWeaponCollision(bool bShouldEnable)
 {
 	// 获取当前装备的武器实例
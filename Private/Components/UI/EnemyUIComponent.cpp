@@ -4,6 +4,18 @@
 #include "Components/UI/EnemyUIComponent.h"
 #include "Widgets/WarriorWidgetBase.h"
 
+void UEnemyUIComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OnCurrentHealthChanged.AddUniqueDynamic(this, &ThisClass::OnOwnerCurrentHealthChanged);
+}
+
+void UEnemyUIComponent::OnOwnerCurrentHealthChanged(float NewPercent)
+{
+	CachedHealthPercent = NewPercent;
+}
+
 void UEnemyUIComponent::RegisterEnemyDrawnWidget(UWarriorWidgetBase* InWidgetToRegister)
 {
 	EnemyDrawnWidgets.Add(InWidgetToRegister);
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/WarriorBehaviorTreeComponent.h"
+
+#include "Subsystems/WarriorBehaviorTreeTickSubsystem.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorStaggeredBehaviorTreeTick(
+	TEXT("warrior.StaggeredBehaviorTreeTick"),
+	true,
+	TEXT("Spread enemy behavior tree updates across frame buckets when the game mode enables it. Set to false to A/B against every-frame ticking."),
+	ECVF_Default);
+
+void UWarriorBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	if (!CachedTickSubsystem.IsValid())
+	{
+		CachedTickSubsystem = GetWorld()->GetSubsystem<UWarriorBehaviorTreeTickSubsystem>();
+	}
+
+	UWarriorBehaviorTreeTickSubsystem* TickSubsystem = CachedTickSubsystem.Get();
+
+	if (TickSubsystem && TickBucket != INDEX_NONE && !TickSubsystem->IsTickBucketActive(TickBucket))
+	{
+		SkippedDeltaTime += DeltaTime;
+
+		// 行为树自身安排的更新间隔可能一再落在其他分组的帧上，跳过后改为逐帧检查，等到本组的帧立即更新
+		// 实际更新后行为树会重新安排间隔
+		SetComponentTickInterval(0.f);
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Super::TickComponent(DeltaTime + SkippedDeltaTime, TickType, ThisTickFunction);
+
+	SkippedDeltaTime = 0.f;
+
+	// 行为树在 Super::TickComponent 中安排了下一次更新，间隔短于显著性级别的要求时拉长到该级别的间隔
+	if (TierTickInterval > 0.f && GetComponentTickInterval() < TierTickInterval)
+	{
+		SetComponentTickInterval(TierTickInterval);
+	}
+
+	if (TickSubsystem)
+	{
+		TickSubsystem->RecordBehaviorTreeTick(FPlatformTime::Seconds() - StartTime);
+	}
+}
+
+bool UWarriorBehaviorTreeComponent::IsStaggeredTickAllowed()
+{
+	return CVarWarriorStaggeredBehaviorTreeTick.GetValueOnGameThread();
+}
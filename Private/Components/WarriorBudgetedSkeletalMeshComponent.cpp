@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/WarriorBudgetedSkeletalMeshComponent.h"
+
+#include "IAnimationBudgetAllocator.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorAnimationBudget(
+	TEXT("warrior.AnimationBudget"),
+	true,
+	TEXT("Allow the animation budget allocator to throttle enemy skeletal meshes when the game mode enables it. Set to false to A/B against full-rate animation."),
+	ECVF_Default);
+
+UWarriorBudgetedSkeletalMeshComponent::UWarriorBudgetedSkeletalMeshComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	SetAutoRegisterWithBudgetAllocator(true);
+	SetAutoCalculateSignificance(false);
+}
+
+bool UWarriorBudgetedSkeletalMeshComponent::IsAnimationBudgetAllowed()
+{
+	return CVarWarriorAnimationBudget.GetValueOnGameThread();
+}
+
+void UWarriorBudgetedSkeletalMeshComponent::SetRegisteredWithAnimationBudget(bool bShouldRegister)
+{
+	IAnimationBudgetAllocator* AnimationBudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+
+	if (!AnimationBudgetAllocator || bShouldRegister == IsManagedByAnimationBudget())
+	{
+		return;
+	}
+
+	if (bShouldRegister)
+	{
+		AnimationBudgetAllocator->RegisterComponent(this);
+	}
+	else
+	{
+		AnimationBudgetAllocator->UnregisterComponent(this);
+	}
+}
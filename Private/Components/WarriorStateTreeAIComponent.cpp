@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/WarriorStateTreeAIComponent.h"
+
+#include "AI/StateTree/WarriorStateTreeAIComponentSchema.h"
+#include "Subsystems/WarriorBehaviorTreeTickSubsystem.h"
+
+void UWarriorStateTreeAIComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	if (!CachedTickSubsystem.IsValid())
+	{
+		CachedTickSubsystem = GetWorld()->GetSubsystem<UWarriorBehaviorTreeTickSubsystem>();
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (UWarriorBehaviorTreeTickSubsystem* TickSubsystem = CachedTickSubsystem.Get())
+	{
+		TickSubsystem->RecordBehaviorTreeTick(FPlatformTime::Seconds() - StartTime);
+	}
+}
+
+TSubclassOf<UStateTreeSchema> UWarriorStateTreeAIComponent::GetSchema() const
+{
+	return UWarriorStateTreeAIComponentSchema::StaticClass();
+}
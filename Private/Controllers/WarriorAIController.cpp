@@ -8,6 +8,20 @@
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
+#include "BrainComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Components/WarriorBehaviorTreeComponent.h"
+#include "Components/WarriorStateTreeAIComponent.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "StateTree.h"
+
+static TAutoConsoleVariable<int32> CVarWarriorEnemyBrainOverride(
+	TEXT("warrior.EnemyBrainOverride"),
+	0,
+	TEXT("0: each enemy class uses its own brain type. 1: force Behavior Trees. 2: force StateTrees for classes that have a StateTree brain asset. Applies on the next possession."),
+	ECVF_Default);
 
 
 AWarriorAIController::AWarriorAIController(const FObjectInitializer& ObjectInitializer)
@@ -32,6 +46,10 @@ AWarriorAIController::AWarriorAIController(const FObjectInitializer& ObjectIniti
 	EnemyPerceptionComponent->OnTargetPerceptionUpdated.AddDynamic(this, &AWarriorAIController::OnEnemyPerceptionUpdated);
 
 	SetGenericTeamId(FGenericTeamId(1));
+
+	// RunBehaviorTree 会复用已有的行为树组件，由它按帧分组更新
+	BehaviorTreeComponent = CreateDefaultSubobject<UWarriorBehaviorTreeComponent>("WarriorBehaviorTreeComponent");
+	BrainComponent = BehaviorTreeComponent;
 	
 
 
@@ -56,33 +74,234 @@ ETeamAttitude::Type AWarriorAIController::GetTeamAttitudeTowards(const AActor& O
 	
 }
 
+void AWarriorAIController::EnterDormancy()
+{
+	if (bIsDormant)
+	{
+		return;
+	}
+
+	bIsDormant = true;
+
+	if (BrainComponent)
+	{
+		BrainComponent->PauseLogic(TEXT("Dormant"));
+	}
+
+	StopMovement();
+
+	// 已经停下，补上移动中未能切换的群体模拟状态
+	if (bCrowdSimulationStatePending)
+	{
+		ApplyCrowdAvoidanceLevel();
+	}
+
+	// 关闭视觉后感知系统不再为该控制器做视线检测
+	RefreshSightPerception();
+	EnemyPerceptionComponent->SetComponentTickEnabled(false);
+}
+
+void AWarriorAIController::ExitDormancy()
+{
+	if (!bIsDormant)
+	{
+		return;
+	}
+
+	bIsDormant = false;
+
+	EnemyPerceptionComponent->SetComponentTickEnabled(true);
+	RefreshSightPerception();
+
+	if (BrainComponent)
+	{
+		BrainComponent->ResumeLogic(TEXT("Dormant"));
+	}
+}
+
+void AWarriorAIController::SetSightPerceptionAllowed(bool bAllowed)
+{
+	bSightAllowedBySignificance = bAllowed;
+
+	RefreshSightPerception();
+}
+
+bool AWarriorAIController::HasTargetActor()
+{
+	return GetTargetActor() != nullptr;
+}
+
+AActor* AWarriorAIController::GetTargetActor()
+{
+	if (IsRunningStateTreeBrain())
+	{
+		return NativeTargetActor.Get();
+	}
+
+	const FBlackboard::FKey TargetActorKeyId = GetTargetActorKeyId();
+
+	return TargetActorKeyId != FBlackboard::InvalidKey
+		? Cast<AActor>(GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(TargetActorKeyId))
+		: nullptr;
+}
+
+void AWarriorAIController::SetTargetActorIfUnset(AActor* InTargetActor)
+{
+	if (!InTargetActor)
+	{
+		return;
+	}
+
+	if (IsRunningStateTreeBrain())
+	{
+		if (!NativeTargetActor.IsValid())
+		{
+			NativeTargetActor = InTargetActor;
+		}
+
+		return;
+	}
+
+	const FBlackboard::FKey TargetActorKeyId = GetTargetActorKeyId();
+
+	if (TargetActorKeyId == FBlackboard::InvalidKey)
+	{
+		return;
+	}
+
+	UBlackboardComponent* BlackboardComponent = GetBlackboardComponent();
+
+	if (!BlackboardComponent->GetValue<UBlackboardKeyType_Object>(TargetActorKeyId))
+	{
+		BlackboardComponent->SetValue<UBlackboardKeyType_Object>(TargetActorKeyId, InTargetActor);
+	}
+}
+
+void AWarriorAIController::RefreshSightPerception()
+{
+	EnemyPerceptionComponent->SetSenseEnabled(UAISense_Sight::StaticClass(),
+		bSightAllowedBySignificance && !bSightDrivenByTargetLocator && !bIsDormant);
+}
+
+void AWarriorAIController::SetCrowdAvoidanceLevel(EWarriorCrowdAvoidanceLevel InLevel)
+{
+	if (!bEnableDetourCrowdAvoidance || (CurrentCrowdAvoidanceLevel == InLevel && !bCrowdSimulationStatePending))
+	{
+		return;
+	}
+
+	CurrentCrowdAvoidanceLevel = InLevel;
+
+	ApplyCrowdAvoidanceLevel();
+}
+
+void AWarriorAIController::ApplyCrowdAvoidanceLevel()
+{
+	UCrowdFollowingComponent* CrowdComp = Cast<UCrowdFollowingComponent>(GetPathFollowingComponent());
+
+	if (!CrowdComp || !bEnableDetourCrowdAvoidance)
+	{
+		return;
+	}
+
+	FWarriorCrowdAvoidanceSettings CrowdAvoidanceSettings;
+
+	if (const AWarriorBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		CrowdAvoidanceSettings = BaseGameMode->GetCrowdAvoidanceSettings();
+	}
+
+	int32 AvoidanceQuality = DetourCrowdAvoidanceQuality;
+	float QueryRange = CollisionQueryRange;
+
+	switch (CurrentCrowdAvoidanceLevel)
+	{
+		case EWarriorCrowdAvoidanceLevel::Medium:
+			AvoidanceQuality = CrowdAvoidanceSettings.MediumAvoidanceQuality;
+			QueryRange = FMath::Min(CollisionQueryRange, CrowdAvoidanceSettings.ReducedCollisionQueryRange);
+			break;
+		case EWarriorCrowdAvoidanceLevel::Low:
+		case EWarriorCrowdAvoidanceLevel::Off:
+			AvoidanceQuality = CrowdAvoidanceSettings.LowAvoidanceQuality;
+			QueryRange = FMath::Min(CollisionQueryRange, CrowdAvoidanceSettings.ReducedCollisionQueryRange);
+			break;
+		default:
+			break;
+	}
+
+	switch (FMath::Clamp(AvoidanceQuality, 1, 4))
+	{
+		case 1:
+			CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Low);
+			break;
+		case 2:
+			CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Medium);
+			break;
+		case 3:
+			CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Good);
+			break;
+		case 4:
+			CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::High);
+			break;
+	}
+
+	CrowdComp -> SetCrowdCollisionQueryRange(QueryRange);
+
+	// Off 等级只作为障碍物留在群体中，其他敌人仍会绕开它
+	const ECrowdSimulationState DesiredSimulationState = CurrentCrowdAvoidanceLevel == EWarriorCrowdAvoidanceLevel::Off
+		? ECrowdSimulationState::ObstacleOnly
+		: ECrowdSimulationState::Enabled;
+
+	if (CrowdComp->GetCrowdSimulationState() == DesiredSimulationState)
+	{
+		bCrowdSimulationStatePending = false;
+	}
+	else if (CrowdComp->GetStatus() == EPathFollowingStatus::Idle)
+	{
+		CrowdComp->SetCrowdSimulationState(DesiredSimulationState);
+		bCrowdSimulationStatePending = false;
+	}
+	else
+	{
+		bCrowdSimulationStatePending = true;
+	}
+}
+
+FBlackboard::FKey AWarriorAIController::GetTargetActorKeyId()
+{
+	const UBlackboardComponent* BlackboardComponent = GetBlackboardComponent();
+	const UBlackboardData* BlackboardAsset = BlackboardComponent ? BlackboardComponent->GetBlackboardAsset() : nullptr;
+
+	if (BlackboardAsset != CachedBlackboardAsset.Get())
+	{
+		CachedBlackboardAsset = BlackboardAsset;
+		CachedTargetActorKeyId = BlackboardAsset ? BlackboardAsset->GetKeyID(FName("TargetActor")) : FBlackboard::InvalidKey;
+	}
+
+	return CachedTargetActorKeyId;
+}
+
 void AWarriorAIController::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (const AWarriorBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		bSightDrivenByTargetLocator = BaseGameMode->GetHeroTargetLocatorSettings().bEnableTargetLocator;
+	}
+
+	RefreshSightPerception();
 	
 	if (UCrowdFollowingComponent* CrowdComp = Cast<UCrowdFollowingComponent>(GetPathFollowingComponent()))
 	{
 		CrowdComp->SetCrowdSimulationState(bEnableDetourCrowdAvoidance ? ECrowdSimulationState::Enabled : ECrowdSimulationState::Disabled);
 
-		switch (DetourCrowdAvoidanceQuality)
-		{
-			case 1:
-				CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Low);
-				break;
-			case 2:
-				CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Medium);
-				break;
-			case 3:
-				CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Good);
-				break;
-			case 4:
-				CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::High);
-				break;
-		}
-
 		CrowdComp -> SetAvoidanceGroup(1);
 		CrowdComp -> SetGroupsToAvoid(1);
-		CrowdComp -> SetCrowdCollisionQueryRange(CollisionQueryRange);
+
+		// 初始为 High 等级，之后由 UWarriorCrowdAvoidanceSubsystem 按距离与密度调整
+		CurrentCrowdAvoidanceLevel = EWarriorCrowdAvoidanceLevel::High;
+		ApplyCrowdAvoidanceLevel();
 
 		
 	}
@@ -90,17 +309,100 @@ void AWarriorAIController::BeginPlay()
 	
 }
 
-void AWarriorAIController::OnEnemyPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
+void AWarriorAIController::OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result)
+{
+	Super::OnMoveCompleted(RequestID, Result);
+
+	// 路径跟随在广播结束前已回到空闲状态，此时可以切换群体模拟状态
+	if (bCrowdSimulationStatePending)
+	{
+		ApplyCrowdAvoidanceLevel();
+	}
+}
+
+bool AWarriorAIController::RunBehaviorTree(UBehaviorTree* BTAsset)
 {
-	if (UBlackboardComponent* BlackboardComponent = GetBlackboardComponent())
+	if (GetStateTreeBrainFor(GetPawn()))
 	{
-		if (!BlackboardComponent->GetValueAsObject(FName("TargetActor")))
+		return false;
+	}
+
+	// 之前运行的是状态树（例如对象池中的控制器改变了大脑类型），换回行为树组件
+	if (StateTreeComponent && BrainComponent == StateTreeComponent)
+	{
+		StateTreeComponent->StopLogic(TEXT("Switching To Behavior Tree"));
+		BrainComponent = BehaviorTreeComponent;
+	}
+
+	return Super::RunBehaviorTree(BTAsset);
+}
+
+bool AWarriorAIController::IsRunningStateTreeBrain() const
+{
+	return StateTreeComponent && BrainComponent == StateTreeComponent;
+}
+
+void AWarriorAIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	if (UStateTree* StateTree = GetStateTreeBrainFor(InPawn))
+	{
+		StartStateTreeBrain(StateTree);
+	}
+}
+
+UStateTree* AWarriorAIController::GetStateTreeBrainFor(const APawn* InPawn) const
+{
+	const AWarriorEnemyCharacter* Enemy = Cast<AWarriorEnemyCharacter>(InPawn);
+
+	if (!Enemy || !Enemy->GetStateTreeBrain())
+	{
+		return nullptr;
+	}
+
+	switch (CVarWarriorEnemyBrainOverride.GetValueOnGameThread())
+	{
+		case 1:
+			return nullptr;
+		case 2:
+			return Enemy->GetStateTreeBrain();
+		default:
+			return Enemy->GetEnemyBrainType() == EWarriorEnemyBrainType::StateTree ? Enemy->GetStateTreeBrain() : nullptr;
+	}
+}
+
+void AWarriorAIController::StartStateTreeBrain(UStateTree* InStateTree)
+{
+	if (!StateTreeComponent)
+	{
+		StateTreeComponent = NewObject<UWarriorStateTreeAIComponent>(this, TEXT("WarriorStateTreeComponent"));
+		StateTreeComponent->RegisterComponent();
+	}
+
+	if (BrainComponent != StateTreeComponent)
+	{
+		if (BrainComponent)
 		{
-			if (Stimulus.WasSuccessfullySensed() && Actor)
-			{
-				BlackboardComponent->SetValueAsObject(FName("TargetActor"), Actor);
-			}
+			BrainComponent->StopLogic(TEXT("Switching To StateTree"));
 		}
+
+		BrainComponent = StateTreeComponent;
+	}
+
+	// 每次占有都是一个新的敌人，不沿用上一次的目标
+	NativeTargetActor.Reset();
+
+	StateTreeComponent->StopLogic(TEXT("Restarting StateTree"));
+	StateTreeComponent->SetStateTree(InStateTree);
+	StateTreeComponent->StartLogic();
+}
+
+void AWarriorAIController::OnEnemyPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
+{
+	if (Stimulus.WasSuccessfullySensed() && Actor)
+	{
+		SetTargetActorIfUnset(Actor);
 	}
 
 	
@@ -3,6 +3,9 @@
 
 #include "Controllers/WarriorHeroController.h"
 
+#include "Blueprint/UserWidget.h"
+#include "Widgets/WarriorEnemyHealthBarLayerWidget.h"
+
 AWarriorHeroController::AWarriorHeroController()
 {
 	HeroTeamId = FGenericTeamId(0);
@@ -12,3 +15,24 @@ FGenericTeamId AWarriorHeroController::GetGenericTeamId() const
 {
 	return HeroTeamId;
 }
+
+void AWarriorHeroController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// 敌人血条改由血条层统一绘制时，由本地玩家控制器把血条层加入视口
+	if (IsLocalController() && UWarriorEnemyHealthBarLayerWidget::IsBatchedHealthBarEnabled())
+	{
+		const TSubclassOf<UWarriorEnemyHealthBarLayerWidget> LayerWidgetClass = EnemyHealthBarLayerWidgetClass
+			? EnemyHealthBarLayerWidgetClass
+			: TSubclassOf<UWarriorEnemyHealthBarLayerWidget>(UWarriorEnemyHealthBarLayerWidget::StaticClass());
+
+		EnemyHealthBarLayerWidget = CreateWidget<UWarriorEnemyHealthBarLayerWidget>(this, LayerWidgetClass);
+
+		check(EnemyHealthBarLayerWidget);
+
+		// 血条层只负责绘制，不拦截鼠标输入
+		EnemyHealthBarLayerWidget->SetVisibility(ESlateVisibility::HitTestInvisible);
+		EnemyHealthBarLayerWidget->AddToViewport();
+	}
+}
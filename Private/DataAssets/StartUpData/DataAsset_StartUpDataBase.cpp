@@ -50,42 +50,8 @@ void UDataAsset_StartUpDataBase::GiveToAbilitySystemComponent(UWarriorAbilitySys
 			// 检查效果规范句柄是否有效
 			if (EffectSpecHandle.IsValid())
 			{
-				// 应用效果规范到自身，而不是直接使用EffectCDO
-				// 这样可以确保所有属性都被正确初始化和处理
-				// 添加空指针检查以防止访问空指针导致的断言失败
-				// if (EffectSpecHandle.Data.IsValid() && EffectSpecHandle.Data.Get())
-				// {
-				// 	InASCToGive->ApplyGameplayEffectSpecToSelf(*EffectSpecHandle.Data.Get());
-				// }
-				
-				// 通过 EffectClass（一个 UGameplayEffect 的子类类型），获取该类的默认对象（CDO，Class Default Object）
-				// 即该效果的模板实例
-				UGameplayEffect* EffectCDO = EffectClass ->GetDefaultObject<UGameplayEffect>();
-				
-				// 检查效果默认对象是否有效
-				if (EffectCDO)
-				{
-					// 调用能力系统组件的 ApplyGameplayEffectToSelf 方法
-					// 将上一步获取到的 GameplayEffect 默认对象以 ApplyLevel 等级和指定的效果上下文（EffectContext）应用到自己身上
-					InASCToGive->ApplyGameplayEffectToSelf(
-						EffectCDO,
-						ApplyLevel,
-						InASCToGive->MakeEffectContext()
-					 );
-				}
-				
-				/* 以下为原始实现方式（已废弃）：
-				 * // 通过 EffectClass（一个 UGameplayEffect 的子类类型），获取该类的默认对象（CDO，Class Default Object）
-				 * // 即该效果的模板实例
-				 * UGameplayEffect* EffectCDO = EffectClass ->GetDefaultObject<UGameplayEffect>();
-				 * // 调用能力系统组件的 ApplyGameplayEffectToSelf 方法
-				 * // 将上一步获取到的 GameplayEffect 默认对象以 ApplyLevel 等级和指定的效果上下文（EffectContext）应用到自己身上
-				 * InASCToGive->ApplyGameplayEffectToSelf(
-				 *     EffectCDO,
-				 *     ApplyLevel,
-				 *     InASCToGive->MakeEffectContext()
-				 * );
-				 */
+				// 直接应用刚构建的效果规范，不再丢弃它后用效果的默认对象重新构建一次
+				InASCToGive->ApplyGameplayEffectSpecToSelf(*EffectSpecHandle.Data.Get());
 			}
 		}
 	}
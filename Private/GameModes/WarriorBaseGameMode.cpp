@@ -7,4 +7,26 @@ AWarriorBaseGameMode::AWarriorBaseGameMode()
 {
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.bStartWithTickEnabled = true;
+
+	FWarriorSignificanceTierSettings& MediumTier = EnemySignificanceSettings.MediumTier;
+	MediumTier.MaxDistance = 3500.f;
+	MediumTier.MinScreenSize = 0.01f;
+	MediumTier.MovementTickInterval = 0.033f;
+	MediumTier.AnimationTickInterval = 0.033f;
+	MediumTier.BehaviorTreeTickInterval = 0.1f;
+	MediumTier.PerceptionTickInterval = 0.2f;
+	MediumTier.CrowdFollowingTickInterval = 0.1f;
+	MediumTier.bEnableUpdateRateOptimizations = true;
+	MediumTier.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+
+	// 远处或屏幕外的敌人降低各组件的更新频率并隐藏血条
+	FWarriorSignificanceTierSettings& LowTier = EnemySignificanceSettings.LowTier;
+	LowTier.MovementTickInterval = 0.1f;
+	LowTier.AnimationTickInterval = 0.1f;
+	LowTier.BehaviorTreeTickInterval = 0.5f;
+	LowTier.PerceptionTickInterval = 1.f;
+	LowTier.CrowdFollowingTickInterval = 0.25f;
+	LowTier.bEnableUpdateRateOptimizations = true;
+	LowTier.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	LowTier.bShowHealthWidget = false;
 }
@@ -3,12 +3,149 @@
 
 #include "GameModes/WarriorSurvivalGameMode.h"
 
-#include "NavigationSystem.h"
-#include "Engine/AssetManager.h"
+#include "Misc/DataValidation.h"
 #include "WarriorDebugHelper.h"
 #include "WarriorFunctionLibrary.h"
-#include "Engine/TargetPoint.h"
-#include "Kismet/GameplayStatics.h"
+#include "Subsystems/WarriorEnemyCrowdSubsystem.h"
+#include "Subsystems/WarriorEnemyPoolSubsystem.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "Subsystems/WarriorPopulationDirectorSubsystem.h"
+#include "Subsystems/WarriorRandomSubsystem.h"
+#include "Subsystems/WarriorSpawnPointSubsystem.h"
+#include "Subsystems/WarriorWaveStreamingSubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Process Enemy Spawn Queue"), STAT_WarriorProcessEnemySpawnQueue, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Spawned This Frame"), STAT_WarriorEnemiesSpawnedThisFrame, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemy Spawn Queue Depth"), STAT_WarriorEnemySpawnQueueDepth, STATGROUP_WarriorSurvival);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Enemy Spawn Latency (ms)"), STAT_WarriorEnemySpawnLatencyMs, STATGROUP_WarriorSurvival);
+
+bool FWarriorCompiledWaveSchedule::Compile(const UDataTable* InWaveSpawnerDataTable, TArray<FText>& OutErrors)
+{
+	*this = FWarriorCompiledWaveSchedule();
+
+	if (!InWaveSpawnerDataTable)
+	{
+		OutErrors.Add(FText::FromString(TEXT("EnemyWaveSpawnerDataTable is not assigned")));
+		return false;
+	}
+
+	if (!InWaveSpawnerDataTable->GetRowStruct() || !InWaveSpawnerDataTable->GetRowStruct()->IsChildOf(FWarriorEnemyWaveSpawnerTableRow::StaticStruct()))
+	{
+		OutErrors.Add(FText::FromString(FString::Printf(TEXT("%s does not use FWarriorEnemyWaveSpawnerTableRow as its row struct"), *InWaveSpawnerDataTable->GetName())));
+		return false;
+	}
+
+	const int32 NumErrorsBeforeCompile = OutErrors.Num();
+	const int32 NumWaves = InWaveSpawnerDataTable->GetRowMap().Num();
+
+	// 仅在编译期使用哈希表去重，运行时通过下标访问
+	TMap<TSoftClassPtr<AWarriorEnemyCharacter>, int32> EnemyClassToIndexMap;
+
+	WavePlans.Reserve(NumWaves);
+
+	for (int32 WaveIndex = 0; WaveIndex < NumWaves; WaveIndex++)
+	{
+		const FName RowName = FName(TEXT("Wave") + FString::FromInt(WaveIndex + 1));
+
+		const FWarriorEnemyWaveSpawnerTableRow* WaveRow = InWaveSpawnerDataTable->FindRow<FWarriorEnemyWaveSpawnerTableRow>(RowName, FString(), false);
+
+		if (!WaveRow)
+		{
+			OutErrors.Add(FText::FromString(FString::Printf(TEXT("%s: missing row %s, rows must be named Wave1..Wave%i"),
+				*InWaveSpawnerDataTable->GetName(), *RowName.ToString(), NumWaves)));
+			continue;
+		}
+
+		FWarriorCompiledWavePlan& WavePlan = WavePlans.AddDefaulted_GetRef();
+		WavePlan.FirstEntryIndex = SpawnerEntries.Num();
+		WavePlan.FirstClassUsageIndex = ClassUsages.Num();
+		WavePlan.TotalEnemyToSpawn = WaveRow->TotalEnemyToSpawnThisWave;
+		WavePlan.EnemiesSpawnedBeforeThisWave = TotalEnemiesAllWaves;
+
+		if (WaveRow->TotalEnemyToSpawnThisWave < 1)
+		{
+			OutErrors.Add(FText::FromString(FString::Printf(TEXT("%s: TotalEnemyToSpawnThisWave must be at least 1"), *RowName.ToString())));
+		}
+
+		int32 CumulativeMaxPerSpawnCount = 0;
+
+		for (const FWarriorEnemyWaveSpawnerInfo& SpawnerInfo : WaveRow->EnemyWaveSpawnerDefinitions)
+		{
+			if (SpawnerInfo.SoftEnemyClassToSpawn.IsNull())
+			{
+				continue;
+			}
+
+			if (SpawnerInfo.MinPerSpawnCount < 0 || SpawnerInfo.MaxPerSpawnCount < SpawnerInfo.MinPerSpawnCount)
+			{
+				OutErrors.Add(FText::FromString(FString::Printf(TEXT("%s: %s has an invalid spawn count range [%i, %i]"),
+					*RowName.ToString(), *SpawnerInfo.SoftEnemyClassToSpawn.ToString(), SpawnerInfo.MinPerSpawnCount, SpawnerInfo.MaxPerSpawnCount)));
+				continue;
+			}
+
+			int32& EnemyClassIndex = EnemyClassToIndexMap.FindOrAdd(SpawnerInfo.SoftEnemyClassToSpawn, INDEX_NONE);
+
+			if (EnemyClassIndex == INDEX_NONE)
+			{
+				EnemyClassIndex = EnemyClasses.Add(SpawnerInfo.SoftEnemyClassToSpawn);
+			}
+
+			CumulativeMaxPerSpawnCount += SpawnerInfo.MaxPerSpawnCount;
+
+			FWarriorCompiledSpawnerEntry& SpawnerEntry = SpawnerEntries.AddDefaulted_GetRef();
+			SpawnerEntry.EnemyClassIndex = EnemyClassIndex;
+			SpawnerEntry.MinPerSpawnCount = SpawnerInfo.MinPerSpawnCount;
+			SpawnerEntry.MaxPerSpawnCount = SpawnerInfo.MaxPerSpawnCount;
+			SpawnerEntry.CumulativeMaxPerSpawnCount = CumulativeMaxPerSpawnCount;
+
+			// 同一类别在一波中可能出现多次，合并为一条用量记录
+			FWarriorCompiledWaveClassUsage* ClassUsage = nullptr;
+
+			for (int32 UsageIndex = WavePlan.FirstClassUsageIndex; UsageIndex < ClassUsages.Num(); UsageIndex++)
+			{
+				if (ClassUsages[UsageIndex].EnemyClassIndex == EnemyClassIndex)
+				{
+					ClassUsage = &ClassUsages[UsageIndex];
+					break;
+				}
+			}
+
+			if (!ClassUsage)
+			{
+				ClassUsage = &ClassUsages.AddDefaulted_GetRef();
+				ClassUsage->EnemyClassIndex = EnemyClassIndex;
+			}
+
+			ClassUsage->MaxPossibleSpawnCount = FMath::Min(ClassUsage->MaxPossibleSpawnCount + SpawnerInfo.MaxPerSpawnCount, WavePlan.TotalEnemyToSpawn);
+		}
+
+		WavePlan.NumEntries = SpawnerEntries.Num() - WavePlan.FirstEntryIndex;
+		WavePlan.NumClassUsages = ClassUsages.Num() - WavePlan.FirstClassUsageIndex;
+
+		// 每批最多生成0个时 ShouldKeepSpawnEnemies 永远为真，这一波将无法结束
+		if (CumulativeMaxPerSpawnCount <= 0)
+		{
+			OutErrors.Add(FText::FromString(FString::Printf(TEXT("%s: no spawner definition can spawn any enemy"), *RowName.ToString())));
+		}
+
+		TotalEnemiesAllWaves += FMath::Max(WavePlan.TotalEnemyToSpawn, 0);
+	}
+
+	if (NumWaves == 0)
+	{
+		OutErrors.Add(FText::FromString(FString::Printf(TEXT("%s has no wave rows"), *InWaveSpawnerDataTable->GetName())));
+	}
+
+	return OutErrors.Num() == NumErrorsBeforeCompile;
+}
+
+AWarriorSurvivalGameMode::AWarriorSurvivalGameMode()
+{
+	// 波次流程由计时器与事件驱动，不需要每帧轮询
+	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+}
 
 void AWarriorSurvivalGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
@@ -28,72 +165,257 @@ void AWarriorSurvivalGameMode::BeginPlay()
 
 	checkf(EnemyWaveSpawnerDataTable, TEXT("Forgot to assign a valid data table in survival game mode blueprint"))
 
-	SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::WaitSpawnNewWave);
+	TArray<FText> WaveScheduleErrors;
+
+	const bool bCompiledWaveSchedule = CompiledWaveSchedule.Compile(EnemyWaveSpawnerDataTable, WaveScheduleErrors);
+
+	checkf(bCompiledWaveSchedule, TEXT("Invalid EnemyWaveSpawnerDataTable: %s"),
+		*FText::Join(FText::FromString(TEXT("; ")), WaveScheduleErrors).ToString());
+
+	UWarriorWaveStreamingSubsystem* WaveStreamingSubsystem = GetWorld()->GetSubsystem<UWarriorWaveStreamingSubsystem>();
+	check(WaveStreamingSubsystem);
+
+	WaveStreamingSubsystem->InitializeWaveSchedule(CompiledWaveSchedule);
+	WaveStreamingSubsystem->OnWaveAssetsReady.AddUObject(this, &ThisClass::OnWaveAssetsReady);
 
-	TotalWavesToSpawn = EnemyWaveSpawnerDataTable->GetRowNames().Num();
+	UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+	check(EnemyRegistrySubsystem);
+
+	EnemyRegistrySubsystem->OnEnemyUnregistered.AddUObject(this, &ThisClass::OnEnemyUnregistered);
+
+	if (UWarriorPopulationDirectorSubsystem* PopulationDirectorSubsystem = GetWorld()->GetSubsystem<UWarriorPopulationDirectorSubsystem>())
+	{
+		PopulationDirectorSubsystem->OnConcurrentEnemyCapChanged.AddUObject(this, &ThisClass::OnConcurrentEnemyCapChanged);
+	}
+
+	TotalWavesToSpawn = CompiledWaveSchedule.GetNumWaves();
+
+	SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::WaitSpawnNewWave);
 
 	PreloadNextWaveEnemies();
 }
 
-void AWarriorSurvivalGameMode::Tick(float DeltaTime)
+void AWarriorSurvivalGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	GetWorldTimerManager().ClearAllTimersForObject(this);
 
-	if (CurrentSurvivalGameModeState == EWarriorSurvivalGameModeState::WaitSpawnNewWave)
+	if (UWarriorWaveStreamingSubsystem* WaveStreamingSubsystem = GetWorld()->GetSubsystem<UWarriorWaveStreamingSubsystem>())
 	{
-		TimePassedSinceStart += DeltaTime;
+		WaveStreamingSubsystem->OnWaveAssetsReady.RemoveAll(this);
+	}
 
-		if (TimePassedSinceStart >= SpawnNewWaveWaitTime)
-		{
-			TimePassedSinceStart = 0.0f;
+	if (UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>())
+	{
+		EnemyRegistrySubsystem->OnEnemyUnregistered.RemoveAll(this);
+	}
 
-			SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::SpawningNewWave);
-		}
+	if (UWarriorPopulationDirectorSubsystem* PopulationDirectorSubsystem = GetWorld()->GetSubsystem<UWarriorPopulationDirectorSubsystem>())
+	{
+		PopulationDirectorSubsystem->OnConcurrentEnemyCapChanged.RemoveAll(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AWarriorSurvivalGameMode::SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState InState)
+{
+	const EWarriorSurvivalGameModeState OldState = CurrentSurvivalGameModeState;
+
+	OnExitSurvivalGameModeState(OldState);
+
+	CurrentSurvivalGameModeState = InState;
+
+	OnEnterSurvivalGameModeState(CurrentSurvivalGameModeState);
+
+	OnSurvivalGameModeStateChanged.Broadcast(CurrentSurvivalGameModeState);
+}
+
+void AWarriorSurvivalGameMode::OnExitSurvivalGameModeState(EWarriorSurvivalGameModeState InOldState)
+{
+	GetWorldTimerManager().ClearTimer(StateTimerHandle);
+}
+
+void AWarriorSurvivalGameMode::OnEnterSurvivalGameModeState(EWarriorSurvivalGameModeState InNewState)
+{
+	switch (InNewState)
+	{
+	case EWarriorSurvivalGameModeState::WaitSpawnNewWave:
+		StartStateTimer(SpawnNewWaveWaitTime, &ThisClass::OnSpawnNewWaveWaitFinished);
+		break;
+
+	case EWarriorSurvivalGameModeState::SpawningNewWave:
+		bSpawnEnemiesDelayFinished = false;
+		StartStateTimer(SpawnEnemiesDelayTime, &ThisClass::OnSpawnEnemiesDelayFinished);
+		break;
+
+	case EWarriorSurvivalGameModeState::WaveCompleted:
+		StartStateTimer(WaveCompletedWaitTime, &ThisClass::OnWaveCompletedWaitFinished);
+		break;
+
+	default:
+		break;
 	}
+}
+
+void AWarriorSurvivalGameMode::StartStateTimer(float InDuration, FStateTimerCallback InTimerCallback)
+{
+	FTimerManager& TimerManager = GetWorldTimerManager();
 
-	if (CurrentSurvivalGameModeState == EWarriorSurvivalGameModeState::SpawningNewWave)
+	StateTimerCallback = InTimerCallback;
+
+	const float ScaledDuration = InDuration / WaveFlowTimeScale;
+
+	// 时长为0时推迟到下一帧，避免在状态切换过程中递归进入下一个状态
+	if (ScaledDuration <= 0.f)
 	{
-		TimePassedSinceStart += DeltaTime;
+		StateTimerHandle = TimerManager.SetTimerForNextTick(this, StateTimerCallback);
+	}
+	else
+	{
+		TimerManager.SetTimer(StateTimerHandle, this, StateTimerCallback, ScaledDuration, false);
+	}
 
-		if (TimePassedSinceStart >= SpawnEnemiesDelayTime)
-		{
-			CurrentSpawnedEnemiesCounter += TrySpawnWaveEnemies();
+	if (bWaveFlowPaused)
+	{
+		TimerManager.PauseTimer(StateTimerHandle);
+	}
+}
 
-			TimePassedSinceStart = 0.0f;
+void AWarriorSurvivalGameMode::OnSpawnNewWaveWaitFinished()
+{
+	SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::SpawningNewWave);
+}
 
-			SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::InProgress);
-		}
+void AWarriorSurvivalGameMode::OnSpawnEnemiesDelayFinished()
+{
+	bSpawnEnemiesDelayFinished = true;
+
+	TryStartSpawningCurrentWave();
+}
+
+void AWarriorSurvivalGameMode::OnWaveCompletedWaitFinished()
+{
+	CurrentWaveCount++;
+
+	if (HasFinishedAllWaves())
+	{
+		SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::AllWavesDone);
+	}
+	else
+	{
+		SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::WaitSpawnNewWave);
+		PreloadNextWaveEnemies();
+	}
+}
+
+void AWarriorSurvivalGameMode::TryStartSpawningCurrentWave()
+{
+	// 延迟结束与资源加载完成两个条件都满足后才开始生成，任一条件后满足时都会再次调用
+	if (CurrentSurvivalGameModeState != EWarriorSurvivalGameModeState::SpawningNewWave || !bSpawnEnemiesDelayFinished || !IsCurrentWaveReady())
+	{
+		return;
 	}
 
-	if (CurrentSurvivalGameModeState == EWarriorSurvivalGameModeState::WaveCompleted)
+	EnqueueWaveEnemySpawns();
+
+	SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::InProgress);
+}
+
+void AWarriorSurvivalGameMode::ScheduleSpawnQueueProcessing()
+{
+	if (bSpawnQueueProcessingScheduled || PendingEnemySpawnQueue.IsEmpty())
 	{
-		TimePassedSinceStart += DeltaTime;
+		return;
+	}
 
-		if (TimePassedSinceStart >= SpawnNewWaveWaitTime)
-		{
-			TimePassedSinceStart = 0.0f;
+	bSpawnQueueProcessingScheduled = true;
+	bSpawnQueueDeferredByPopulationCap = false;
 
-			CurrentWaveCount++;
+	GetWorldTimerManager().SetTimerForNextTick(this, &ThisClass::ProcessPendingEnemySpawnQueue);
+}
 
-			if (HasFinishedAllWaves())
-			{
-				SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::AllWavesDone);
-			}
-			else
-			{
-				SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::WaitSpawnNewWave);
-				PreloadNextWaveEnemies();
-			}
+void AWarriorSurvivalGameMode::WarriorPauseWaveFlow()
+{
+	bWaveFlowPaused = true;
+
+	GetWorldTimerManager().PauseTimer(StateTimerHandle);
+}
+
+void AWarriorSurvivalGameMode::WarriorResumeWaveFlow()
+{
+	bWaveFlowPaused = false;
+
+	GetWorldTimerManager().UnPauseTimer(StateTimerHandle);
+}
+
+void AWarriorSurvivalGameMode::WarriorFastForwardWaveFlow()
+{
+	FTimerManager& TimerManager = GetWorldTimerManager();
+
+	if (!TimerManager.TimerExists(StateTimerHandle))
+	{
+		return;
+	}
+
+	// 下一帧触发当前计时器，暂停状态下也会生效
+	TimerManager.ClearTimer(StateTimerHandle);
+
+	StateTimerHandle = TimerManager.SetTimerForNextTick(this, StateTimerCallback);
+}
+
+void AWarriorSurvivalGameMode::WarriorSetWaveFlowTimeScale(float InTimeScale)
+{
+	const float NewTimeScale = FMath::Max(InTimeScale, KINDA_SMALL_NUMBER);
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+
+	// 按新的缩放重新设置当前计时器的剩余时间
+	if (TimerManager.TimerExists(StateTimerHandle))
+	{
+		const float RemainingTime = TimerManager.GetTimerRemaining(StateTimerHandle) * WaveFlowTimeScale / NewTimeScale;
+
+		TimerManager.ClearTimer(StateTimerHandle);
+
+		if (RemainingTime > 0.f)
+		{
+			TimerManager.SetTimer(StateTimerHandle, this, StateTimerCallback, RemainingTime, false);
+		}
+		else
+		{
+			StateTimerHandle = TimerManager.SetTimerForNextTick(this, StateTimerCallback);
+		}
+
+		if (bWaveFlowPaused)
+		{
+			TimerManager.PauseTimer(StateTimerHandle);
 		}
 	}
+
+	WaveFlowTimeScale = NewTimeScale;
 }
 
-void AWarriorSurvivalGameMode::SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState InState)
+#if WITH_EDITOR
+EDataValidationResult AWarriorSurvivalGameMode::IsDataValid(FDataValidationContext& Context) const
 {
-	CurrentSurvivalGameModeState = InState;
+	EDataValidationResult Result = Super::IsDataValid(Context);
 
-	OnSurvivalGameModeStateChanged.Broadcast(CurrentSurvivalGameModeState);
+	// 在编辑器中提前暴露数据表错误，而不是等到运行到某一波时才触发断言
+	FWarriorCompiledWaveSchedule ValidationSchedule;
+	TArray<FText> WaveScheduleErrors;
+
+	if (!ValidationSchedule.Compile(EnemyWaveSpawnerDataTable, WaveScheduleErrors))
+	{
+		for (const FText& WaveScheduleError : WaveScheduleErrors)
+		{
+			Context.AddError(WaveScheduleError);
+		}
+
+		Result = EDataValidationResult::Invalid;
+	}
+
+	return Result;
 }
+#endif
 
 bool AWarriorSurvivalGameMode::HasFinishedAllWaves() const
 {
@@ -107,123 +429,372 @@ void AWarriorSurvivalGameMode::PreloadNextWaveEnemies()
 		return;
 	}
 
-	PreLoadedEnemyClassMap.Empty();
+	UWarriorWaveStreamingSubsystem* WaveStreamingSubsystem = GetWorld()->GetSubsystem<UWarriorWaveStreamingSubsystem>();
+	check(WaveStreamingSubsystem);
 
-	for (const FWarriorEnemyWaveSpawnerInfo& SpawnerInfo : GetCurrentWaveSpawnerTableRow()->EnemyWaveSpawnerDefinitions)
+	WaveStreamingSubsystem->UpdateStreaming(CurrentWaveCount - 1);
+
+	// 当前波次的资源可能已在之前的波次中提前加载完成，此时不会再收到就绪通知
+	if (IsCurrentWaveReady())
 	{
-		if (SpawnerInfo.SoftEnemyClassToSpawn.IsNull())
-		{
-			continue;
-		}
+		OnWaveAssetsReady(CurrentWaveCount - 1);
+	}
+}
 
-		UAssetManager::GetStreamableManager().RequestAsyncLoad(
-			SpawnerInfo.SoftEnemyClassToSpawn.ToSoftObjectPath(),
-			FStreamableDelegate::CreateLambda(
-				[SpawnerInfo, this]()
-				{
-					if (UClass* LoadedEnemyClass = SpawnerInfo.SoftEnemyClassToSpawn.Get())
-					{
-						PreLoadedEnemyClassMap.Emplace(SpawnerInfo.SoftEnemyClassToSpawn, LoadedEnemyClass);
-						
-						// Debug::Print(FString::Printf(TEXT("%s is Loaded"), *LoadedEnemyClass->GetName()), FColor::Green);
-					}
-				}
-			)
-		);
+bool AWarriorSurvivalGameMode::IsCurrentWaveReady() const
+{
+	const UWarriorWaveStreamingSubsystem* WaveStreamingSubsystem = GetWorld()->GetSubsystem<UWarriorWaveStreamingSubsystem>();
+
+	return WaveStreamingSubsystem && WaveStreamingSubsystem->IsWaveReady(CurrentWaveCount - 1);
+}
+
+void AWarriorSurvivalGameMode::OnWaveAssetsReady(int32 InWaveIndex)
+{
+	if (InWaveIndex != CurrentWaveCount - 1)
+	{
+		return;
 	}
+
+	TryStartSpawningCurrentWave();
+
+	const UWarriorWaveStreamingSubsystem* WaveStreamingSubsystem = GetWorld()->GetSubsystem<UWarriorWaveStreamingSubsystem>();
+	UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>();
+
+	if (!WaveStreamingSubsystem || !EnemyPoolSubsystem)
+	{
+		return;
+	}
+
+	// 在等待新一波的阶段预热对象池，把生成开销挪出战斗阶段；按每帧预算分批生成，避免一帧内生成整波角色
+	const FWarriorCompiledWavePlan& WavePlan = GetCurrentWavePlan();
+
+	for (int32 UsageIndex = WavePlan.FirstClassUsageIndex; UsageIndex < WavePlan.FirstClassUsageIndex + WavePlan.NumClassUsages; UsageIndex++)
+	{
+		const FWarriorCompiledWaveClassUsage& ClassUsage = CompiledWaveSchedule.ClassUsages[UsageIndex];
+
+		EnemyPoolSubsystem->QueuePrewarmEnemies(CompiledWaveSchedule.EnemyClasses[ClassUsage.EnemyClassIndex],
+			WaveStreamingSubsystem->GetLoadedEnemyClass(ClassUsage.EnemyClassIndex), ClassUsage.MaxPossibleSpawnCount);
+	}
+}
+
+const FWarriorCompiledWavePlan& AWarriorSurvivalGameMode::GetCurrentWavePlan() const
+{
+	return CompiledWaveSchedule.WavePlans[CurrentWaveCount - 1];
 }
 
-FWarriorEnemyWaveSpawnerTableRow* AWarriorSurvivalGameMode::GetCurrentWaveSpawnerTableRow() const
+int32 AWarriorSurvivalGameMode::EnqueueWaveEnemySpawns()
 {
-	const FName RowName = FName(TEXT("Wave") + FString::FromInt(CurrentWaveCount));
+	const UWarriorSpawnPointSubsystem* SpawnPointSubsystem = GetWorld()->GetSubsystem<UWarriorSpawnPointSubsystem>();
+
+	checkf(SpawnPointSubsystem && SpawnPointSubsystem->HasSpawnAnchors(), TEXT("No Target Points found in the level %s for spawning enemies"), *GetWorld()->GetName());
+
+	int32 EnemiesEnqueuedThisTime = 0;
+
+	FRandomStream& WaveCompositionStream = GetWorld()->GetSubsystem<UWarriorRandomSubsystem>()->GetStream(EWarriorRandomStream::WaveComposition);
 
-	FWarriorEnemyWaveSpawnerTableRow* FoundRow = EnemyWaveSpawnerDataTable->FindRow<FWarriorEnemyWaveSpawnerTableRow>(RowName, FString());
+	const double EnqueueTimeSeconds = FPlatformTime::Seconds();
 
-	checkf(FoundRow, TEXT("Could not find row %s in EnemyWaveSpawnerDataTable"), *RowName.ToString());
+	const FWarriorCompiledWavePlan& WavePlan = GetCurrentWavePlan();
+	const UWarriorWaveStreamingSubsystem* WaveStreamingSubsystem = GetWorld()->GetSubsystem<UWarriorWaveStreamingSubsystem>();
 
-	return FoundRow;
+	for (int32 EntryIndex = WavePlan.FirstEntryIndex; EntryIndex < WavePlan.FirstEntryIndex + WavePlan.NumEntries; EntryIndex++)
+	{
+		const FWarriorCompiledSpawnerEntry& SpawnerEntry = CompiledWaveSchedule.SpawnerEntries[EntryIndex];
+
+		const int32 NumToSpawn = WaveCompositionStream.RandRange(SpawnerEntry.MinPerSpawnCount, SpawnerEntry.MaxPerSpawnCount);
+
+		// 加载失败的类别不入队，但照常计入本波总数，波次仍能按原定数量结束
+		const bool bEnemyClassFailed = WaveStreamingSubsystem && WaveStreamingSubsystem->IsEnemyClassFailed(SpawnerEntry.EnemyClassIndex);
+
+		for (int32 i = 0; i < NumToSpawn; i++)
+		{
+			// 入队即计入本波总数，保证 ShouldKeepSpawnEnemies 不会因为排队中的敌人而超发
+			if (!bEnemyClassFailed)
+			{
+				FWarriorPendingEnemySpawn& PendingSpawn = PendingEnemySpawnQueue.AddDefaulted_GetRef();
+				PendingSpawn.EnemyClassIndex = SpawnerEntry.EnemyClassIndex;
+				PendingSpawn.EnqueueTimeSeconds = EnqueueTimeSeconds;
+
+				EnemiesEnqueuedThisTime++;
+			}
+
+			TotalSpawnedEnemiesThisWaveCounter++;
+
+			if (!ShouldKeepSpawnEnemies())
+			{
+				break;
+			}
+		}
+
+		if (!ShouldKeepSpawnEnemies())
+		{
+			break;
+		}
+	}
+
+	SpawnQueueStats.CurrentQueueDepth = PendingEnemySpawnQueue.Num();
+	SpawnQueueStats.MaxQueueDepth = FMath::Max(SpawnQueueStats.MaxQueueDepth, SpawnQueueStats.CurrentQueueDepth);
+	SET_DWORD_STAT(STAT_WarriorEnemySpawnQueueDepth, SpawnQueueStats.CurrentQueueDepth);
+
+	ScheduleSpawnQueueProcessing();
+
+	// 全部跳过时没有请求会触发队列处理，下一帧再检查本波是否需要补充或已经结束
+	if (EnemiesEnqueuedThisTime == 0 && PendingEnemySpawnQueue.IsEmpty())
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &ThisClass::CheckWaveProgress);
+	}
+
+	BroadcastEnemyPopulationChanged();
+
+	return EnemiesEnqueuedThisTime;
 }
 
-int32 AWarriorSurvivalGameMode::TrySpawnWaveEnemies()
+void AWarriorSurvivalGameMode::ProcessPendingEnemySpawnQueue()
 {
-	if (TargetPointArray.IsEmpty())
+	bSpawnQueueProcessingScheduled = false;
+
+	if (PendingEnemySpawnQueue.IsEmpty())
 	{
-		UGameplayStatics::GetAllActorsOfClass(this, ATargetPoint::StaticClass(), TargetPointArray);
+		return;
 	}
 
-	checkf(!TargetPointArray.IsEmpty(), TEXT("No Target Points found in the level %s for spawning enemies"), *GetWorld()->GetName());
+	SCOPE_CYCLE_COUNTER(STAT_WarriorProcessEnemySpawnQueue);
 
-	uint32 EnemiesSpawnedThisTime = 0;
+	const double StartTimeSeconds = FPlatformTime::Seconds();
+	const double FrameBudgetSeconds = EnemySpawnFrameBudgetMs / 1000.0;
 
-	FActorSpawnParameters SpawnParam;
-	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	UWarriorPopulationDirectorSubsystem* PopulationDirectorSubsystem = GetWorld()->GetSubsystem<UWarriorPopulationDirectorSubsystem>();
+	const UWarriorEnemyCrowdSubsystem* EnemyCrowdSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyCrowdSubsystem>();
 
-	for (const FWarriorEnemyWaveSpawnerInfo& SpawnerInfo : GetCurrentWaveSpawnerTableRow()->EnemyWaveSpawnerDefinitions)
+	const bool bCrowdTierEnabled = EnemyCrowdSubsystem && EnemyCrowdSubsystem->IsCrowdTierEnabled();
+
+	int32 NumProcessed = 0;
+
+	while (NumProcessed < PendingEnemySpawnQueue.Num())
 	{
-		if (SpawnerInfo.SoftEnemyClassToSpawn.IsNull())
+		if (MaxEnemySpawnsPerFrame > 0 && NumProcessed >= MaxEnemySpawnsPerFrame)
 		{
-			continue;
+			break;
 		}
 
-		const int32 NumToSpawn = FMath::RandRange(SpawnerInfo.MinPerSpawnCount, SpawnerInfo.MaxPerSpawnCount);
+		// 每帧至少处理一个请求，之后超出时间预算就留到下一帧
+		if (NumProcessed > 0 && FPlatformTime::Seconds() - StartTimeSeconds >= FrameBudgetSeconds)
+		{
+			break;
+		}
 
-		UClass* LoadedEnemyClass = PreLoadedEnemyClassMap.FindChecked(SpawnerInfo.SoftEnemyClassToSpawn);
+		const bool bHasCharacterSlot = !PopulationDirectorSubsystem || PopulationDirectorSubsystem->RequestSpawnSlot(GetNumLiveWaveCharacters());
 
-		for (int32 i = 0; i < NumToSpawn; i++)
+		// 达到同时存活上限时把剩余请求留在队列中，等待有敌人离场或上限提高；启用群体层时改为生成群体实体
+		if (!bHasCharacterSlot && !bCrowdTierEnabled)
 		{
-			const int32 RandomTargetPointIndex = FMath::RandRange(0, TargetPointArray.Num() - 1);
-			const FVector SpawnOrigin = TargetPointArray[RandomTargetPointIndex]->GetActorLocation();
-			const FRotator SpawnRotation = TargetPointArray[RandomTargetPointIndex]->GetActorForwardVector().ToOrientationRotator();
+			bSpawnQueueDeferredByPopulationCap = true;
+			break;
+		}
 
-			FVector RandomLocation;
+		SpawnQueuedEnemy(PendingEnemySpawnQueue[NumProcessed], !bHasCharacterSlot);
 
-			UNavigationSystemV1::K2_GetRandomReachablePointInRadius(this, SpawnOrigin, RandomLocation, 400.0f);
+		NumProcessed++;
+	}
 
-			RandomLocation += FVector(0.0f, 0.0f, 150.0f);
+	PendingEnemySpawnQueue.RemoveAt(0, NumProcessed, EAllowShrinking::No);
 
-			AWarriorEnemyCharacter* SpawnedEnemy = GetWorld()->SpawnActor<AWarriorEnemyCharacter>(LoadedEnemyClass, RandomLocation, SpawnRotation, SpawnParam);
+	INC_DWORD_STAT_BY(STAT_WarriorEnemiesSpawnedThisFrame, NumProcessed);
 
-			if (SpawnedEnemy)
-			{
-				SpawnedEnemy->OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnEnemyDestroyed);
-				
-				EnemiesSpawnedThisTime++;
-				TotalSpawnedEnemiesThisWaveCounter++;
-			}
+	SpawnQueueStats.CurrentQueueDepth = PendingEnemySpawnQueue.Num();
+	SET_DWORD_STAT(STAT_WarriorEnemySpawnQueueDepth, SpawnQueueStats.CurrentQueueDepth);
 
-			if (!ShouldKeepSpawnEnemies())
-			{
-				return EnemiesSpawnedThisTime;
-			}
-			
+	// 生成失败的请求会退回本波总数，队列清空后需要重新检查本波是否还要补充或已经结束
+	if (PendingEnemySpawnQueue.IsEmpty() && CurrentSurvivalGameModeState == EWarriorSurvivalGameModeState::InProgress)
+	{
+		CheckWaveProgress();
+	}
+
+	if (NumProcessed > 0)
+	{
+		BroadcastEnemyPopulationChanged();
+	}
+
+	if (!bSpawnQueueDeferredByPopulationCap)
+	{
+		ScheduleSpawnQueueProcessing();
+	}
+}
+
+bool AWarriorSurvivalGameMode::SpawnQueuedEnemy(const FWarriorPendingEnemySpawn& InPendingSpawn, bool bSpawnAsCrowdEntity)
+{
+	UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>();
+	check(EnemyPoolSubsystem);
+
+	const TSoftClassPtr<AWarriorEnemyCharacter>& SoftEnemyClass = CompiledWaveSchedule.EnemyClasses[InPendingSpawn.EnemyClassIndex];
+	UClass* LoadedEnemyClass = GetWorld()->GetSubsystem<UWarriorWaveStreamingSubsystem>()->GetLoadedEnemyClass(InPendingSpawn.EnemyClassIndex);
+
+	checkf(LoadedEnemyClass, TEXT("Enemy class %s has not been preloaded"), *SoftEnemyClass.ToString());
+
+	const UWarriorSpawnPointSubsystem* SpawnPointSubsystem = GetWorld()->GetSubsystem<UWarriorSpawnPointSubsystem>();
+	check(SpawnPointSubsystem);
+
+	FVector SpawnGroundLocation;
+	FRotator SpawnRotation;
+
+	SpawnPointSubsystem->PickWaveSpawnPoint(SpawnGroundLocation, SpawnRotation);
+
+	UWarriorEnemyCrowdSubsystem* EnemyCrowdSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyCrowdSubsystem>();
+
+	// 远离玩家的敌人先以群体实体存在，进入交战半径后再由群体层提升为完整角色
+	if (EnemyCrowdSubsystem && EnemyCrowdSubsystem->IsCrowdTierEnabled()
+		&& (bSpawnAsCrowdEntity || EnemyCrowdSubsystem->ShouldSpawnAsCrowdEntity(SpawnGroundLocation)))
+	{
+		EnemyCrowdSubsystem->AddCrowdEntity(SoftEnemyClass, LoadedEnemyClass, SpawnGroundLocation);
+	}
+	else
+	{
+		const FVector SpawnLocation = UWarriorSpawnPointSubsystem::GetSpawnLocationForEnemyClass(SpawnGroundLocation, LoadedEnemyClass);
+
+		AWarriorEnemyCharacter* SpawnedEnemy = EnemyPoolSubsystem->AcquireEnemy(SoftEnemyClass, LoadedEnemyClass, SpawnLocation, SpawnRotation);
+
+		if (!SpawnedEnemy)
+		{
+			// 生成失败不计入本波总数，与直接生成时的语义保持一致
+			TotalSpawnedEnemiesThisWaveCounter--;
+			SpawnQueueStats.FailedSpawns++;
+
+			return false;
 		}
+
+		GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>()->MarkEnemyAsWaveEnemy(SpawnedEnemy);
 	}
-		
-	return EnemiesSpawnedThisTime;
-	
+
+	const float SpawnLatencyMs = static_cast<float>((FPlatformTime::Seconds() - InPendingSpawn.EnqueueTimeSeconds) * 1000.0);
+
+	SpawnQueueStats.SpawnedFromQueue++;
+	SpawnQueueStats.LastSpawnLatencyMs = SpawnLatencyMs;
+	SpawnQueueStats.MaxSpawnLatencyMs = FMath::Max(SpawnQueueStats.MaxSpawnLatencyMs, SpawnLatencyMs);
+
+	TotalSpawnLatencyMs += SpawnLatencyMs;
+	SpawnQueueStats.AverageSpawnLatencyMs = static_cast<float>(TotalSpawnLatencyMs / SpawnQueueStats.SpawnedFromQueue);
+
+	SET_FLOAT_STAT(STAT_WarriorEnemySpawnLatencyMs, SpawnLatencyMs);
+
+	return true;
 }
 
 bool AWarriorSurvivalGameMode::ShouldKeepSpawnEnemies() const
 {
-	return TotalSpawnedEnemiesThisWaveCounter < GetCurrentWaveSpawnerTableRow()->TotalEnemyToSpawnThisWave;
+	if (HasFinishedAllWaves())
+	{
+		return false;
+	}
+
+	return TotalSpawnedEnemiesThisWaveCounter < GetCurrentWavePlan().TotalEnemyToSpawn;
 }
 
-void AWarriorSurvivalGameMode::OnEnemyDestroyed(AActor* DestroyedActor)
+void AWarriorSurvivalGameMode::CheckWaveProgress()
 {
-	CurrentSpawnedEnemiesCounter--;
+	if (ShouldKeepSpawnEnemies())
+	{
+		// 补充请求与开波请求走同一个队列，由每帧预算统一消化
+		if (PendingEnemySpawnQueue.IsEmpty() && GetNumLiveWaveEnemies() <= 0)
+		{
+			EnqueueWaveEnemySpawns();
+		}
 
-	Debug::Print(FString::Printf(TEXT("Current Spawned Enemies Counter: %i , Total Spawned Enemies Counter: %i"), CurrentSpawnedEnemiesCounter, TotalSpawnedEnemiesThisWaveCounter));
+		return;
+	}
+
+	if (GetNumLiveWaveEnemies() > 0 || !PendingEnemySpawnQueue.IsEmpty())
+	{
+		return;
+	}
+
+	TotalSpawnedEnemiesThisWaveCounter = 0;
+
+	if (const UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>())
+	{
+		const FWarriorEnemyPoolStats PoolStats = EnemyPoolSubsystem->GetEnemyPoolStats();
+
+		UE_LOG(LogTemp, Log, TEXT("Wave %i completed. Enemy pool hits: %i, misses: %i, released: %i, prewarmed: %i"),
+			CurrentWaveCount, PoolStats.PoolHits, PoolStats.PoolMisses, PoolStats.ReleasedToPool, PoolStats.PrewarmedEnemies);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Wave %i spawn queue. Spawned: %i, failed: %i, max depth: %i, latency avg: %.2fms, max: %.2fms"),
+		CurrentWaveCount, SpawnQueueStats.SpawnedFromQueue, SpawnQueueStats.FailedSpawns, SpawnQueueStats.MaxQueueDepth,
+		SpawnQueueStats.AverageSpawnLatencyMs, SpawnQueueStats.MaxSpawnLatencyMs);
+
+	SpawnQueueStats = FWarriorEnemySpawnQueueStats();
+	TotalSpawnLatencyMs = 0.0;
+
+	SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::WaveCompleted);
+}
+
+void AWarriorSurvivalGameMode::OnEnemyUnregistered(AWarriorEnemyCharacter* InUnregisteredEnemy, bool bWasWaveEnemy)
+{
+	// 关卡卸载时敌人的 EndPlay 同样会注销，此时不再推进波次
+	if (!bWasWaveEnemy || GetWorld()->bIsTearingDown)
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("Current Spawned Enemies Counter: %i , Total Spawned Enemies Counter: %i"), GetNumLiveWaveEnemies(), TotalSpawnedEnemiesThisWaveCounter);
+
+	// 空出的名额先留给此前被推迟的请求
+	ScheduleSpawnQueueProcessing();
 
 	if (ShouldKeepSpawnEnemies())
 	{
-		CurrentSpawnedEnemiesCounter += TrySpawnWaveEnemies();
+		EnqueueWaveEnemySpawns();
+	}
+	else
+	{
+		CheckWaveProgress();
 	}
 
-	else if (CurrentSpawnedEnemiesCounter <= 0)
+	BroadcastEnemyPopulationChanged();
+}
+
+int32 AWarriorSurvivalGameMode::GetNumLiveWaveEnemies() const
+{
+	const UWarriorEnemyCrowdSubsystem* EnemyCrowdSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyCrowdSubsystem>();
+
+	// 群体层只容纳波次敌人
+	return GetNumLiveWaveCharacters() + (EnemyCrowdSubsystem ? EnemyCrowdSubsystem->GetNumCrowdEntities() : 0);
+}
+
+int32 AWarriorSurvivalGameMode::GetNumLiveWaveCharacters() const
+{
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+
+	return EnemyRegistrySubsystem ? EnemyRegistrySubsystem->GetNumWaveEnemies() : 0;
+}
+
+void AWarriorSurvivalGameMode::RegisterSpawnedEnemy(const TArray<AWarriorEnemyCharacter*>& InEnemyToRegister)
+{
+	UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+	check(EnemyRegistrySubsystem);
+
+	for (AWarriorEnemyCharacter* SpawnedEnemy : InEnemyToRegister)
 	{
-		TotalSpawnedEnemiesThisWaveCounter = 0;
-		CurrentSpawnedEnemiesCounter = 0;
+		if (SpawnedEnemy)
+		{
+			EnemyRegistrySubsystem->MarkEnemyAsWaveEnemy(SpawnedEnemy);
+		}
+	}
+}
 
-		SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState::WaveCompleted);
+void AWarriorSurvivalGameMode::OnConcurrentEnemyCapChanged(int32 InNewConcurrentEnemyCap)
+{
+	if (bSpawnQueueDeferredByPopulationCap)
+	{
+		ScheduleSpawnQueueProcessing();
 	}
+
+	BroadcastEnemyPopulationChanged();
+}
+
+void AWarriorSurvivalGameMode::BroadcastEnemyPopulationChanged()
+{
+	const UWarriorPopulationDirectorSubsystem* PopulationDirectorSubsystem = GetWorld()->GetSubsystem<UWarriorPopulationDirectorSubsystem>();
+
+	OnEnemyPopulationChanged.Broadcast(GetNumLiveWaveEnemies(), PendingEnemySpawnQueue.Num(),
+		PopulationDirectorSubsystem ? PopulationDirectorSubsystem->GetConcurrentEnemyCap() : 0);
 }
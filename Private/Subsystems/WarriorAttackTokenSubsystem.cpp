@@ -0,0 +1,252 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Melee Tokens"), STAT_WarriorActiveMeleeTokens, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Ranged Tokens"), STAT_WarriorActiveRangedTokens, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Tokens Granted"), STAT_WarriorAttackTokensGranted, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Token Waits"), STAT_WarriorAttackTokenWaits, STATGROUP_WarriorSurvival);
+
+void UWarriorAttackTokenSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		TokenSettings = BaseGameMode->GetAttackTokenSettings();
+	}
+
+	if (UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = InWorld.GetSubsystem<UWarriorEnemyRegistrySubsystem>())
+	{
+		EnemyRegistrySubsystem->OnEnemyUnregistered.AddUObject(this, &ThisClass::OnEnemyUnregistered);
+	}
+}
+
+void UWarriorAttackTokenSubsystem::Deinitialize()
+{
+	if (UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>())
+	{
+		EnemyRegistrySubsystem->OnEnemyUnregistered.RemoveAll(this);
+	}
+
+	Super::Deinitialize();
+}
+
+bool UWarriorAttackTokenSubsystem::TryAcquireAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType)
+{
+	if (!InHolder || InTokenType >= EWarriorAttackTokenType::MAX)
+	{
+		return false;
+	}
+
+	if (!TokenSettings.bEnableAttackTokens)
+	{
+		return true;
+	}
+
+	FAttackTokenPool& TokenPool = TokenPools[static_cast<int32>(InTokenType)];
+	const TObjectKey<AActor> HolderKey(InHolder);
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	if (TokenPool.FindHolderIndex(HolderKey) != INDEX_NONE)
+	{
+		return true;
+	}
+
+	ReclaimExpiredTokens(TokenPool, CurrentTime);
+
+	if (!CanGrantAttackToken(TokenPool, HolderKey, InTokenType, CurrentTime))
+	{
+		MarkWaitingForAttackToken(InHolder, InTokenType);
+		return false;
+	}
+
+	double WaitStartTime;
+
+	if (TokenPool.WaitStartTimes.RemoveAndCopyValue(HolderKey, WaitStartTime))
+	{
+		RecordWaitTime(CurrentTime - WaitStartTime);
+	}
+
+	TokenPool.Holders.Add({HolderKey, CurrentTime});
+	TokenPool.LastGrantTime = CurrentTime;
+
+	TokenStats.TokensGranted++;
+	INC_DWORD_STAT(STAT_WarriorAttackTokensGranted);
+
+	if (InTokenType == EWarriorAttackTokenType::Melee)
+	{
+		INC_DWORD_STAT(STAT_WarriorActiveMeleeTokens);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_WarriorActiveRangedTokens);
+	}
+
+	return true;
+}
+
+bool UWarriorAttackTokenSubsystem::CanAcquireAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType) const
+{
+	if (!InHolder || InTokenType >= EWarriorAttackTokenType::MAX)
+	{
+		return false;
+	}
+
+	if (!TokenSettings.bEnableAttackTokens)
+	{
+		return true;
+	}
+
+	const FAttackTokenPool& TokenPool = TokenPools[static_cast<int32>(InTokenType)];
+	const TObjectKey<AActor> HolderKey(InHolder);
+
+	return TokenPool.FindHolderIndex(HolderKey) != INDEX_NONE
+		|| CanGrantAttackToken(TokenPool, HolderKey, InTokenType, GetWorld()->GetTimeSeconds());
+}
+
+void UWarriorAttackTokenSubsystem::MarkWaitingForAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType)
+{
+	if (!InHolder || InTokenType >= EWarriorAttackTokenType::MAX || !TokenSettings.bEnableAttackTokens)
+	{
+		return;
+	}
+
+	FAttackTokenPool& TokenPool = TokenPools[static_cast<int32>(InTokenType)];
+	const TObjectKey<AActor> HolderKey(InHolder);
+
+	if (TokenPool.WaitStartTimes.Contains(HolderKey) || TokenPool.FindHolderIndex(HolderKey) != INDEX_NONE)
+	{
+		return;
+	}
+
+	TokenPool.WaitStartTimes.Add(HolderKey, GetWorld()->GetTimeSeconds());
+
+	TokenStats.TokenWaits++;
+	INC_DWORD_STAT(STAT_WarriorAttackTokenWaits);
+}
+
+void UWarriorAttackTokenSubsystem::ReleaseAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType)
+{
+	if (!InHolder || InTokenType >= EWarriorAttackTokenType::MAX)
+	{
+		return;
+	}
+
+	FAttackTokenPool& TokenPool = TokenPools[static_cast<int32>(InTokenType)];
+	const TObjectKey<AActor> HolderKey(InHolder);
+	const int32 HolderIndex = TokenPool.FindHolderIndex(HolderKey);
+
+	// 没拿到名额就离开分支的敌人不再计入等待
+	TokenPool.WaitStartTimes.Remove(HolderKey);
+
+	if (HolderIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	TokenPool.Holders.RemoveAtSwap(HolderIndex, 1, EAllowShrinking::No);
+	TokenPool.ReleaseTimes.Add(HolderKey, GetWorld()->GetTimeSeconds());
+
+	if (InTokenType == EWarriorAttackTokenType::Melee)
+	{
+		DEC_DWORD_STAT(STAT_WarriorActiveMeleeTokens);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_WarriorActiveRangedTokens);
+	}
+}
+
+bool UWarriorAttackTokenSubsystem::HasAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType) const
+{
+	if (!InHolder || InTokenType >= EWarriorAttackTokenType::MAX)
+	{
+		return false;
+	}
+
+	return TokenPools[static_cast<int32>(InTokenType)].FindHolderIndex(TObjectKey<AActor>(InHolder)) != INDEX_NONE;
+}
+
+int32 UWarriorAttackTokenSubsystem::GetMaxTokens(EWarriorAttackTokenType InTokenType) const
+{
+	return InTokenType == EWarriorAttackTokenType::Melee ? TokenSettings.MaxMeleeTokens : TokenSettings.MaxRangedTokens;
+}
+
+bool UWarriorAttackTokenSubsystem::CanGrantAttackToken(const FAttackTokenPool& InTokenPool, const TObjectKey<AActor>& InHolder,
+	EWarriorAttackTokenType InTokenType, double InCurrentTime) const
+{
+	int32 NumActiveHolders = 0;
+
+	for (const FAttackTokenHolder& Holder : InTokenPool.Holders)
+	{
+		if (TokenSettings.TokenTimeout <= 0.f || InCurrentTime - Holder.GrantTime < TokenSettings.TokenTimeout)
+		{
+			NumActiveHolders++;
+		}
+	}
+
+	const double* LastReleaseTime = InTokenPool.ReleaseTimes.Find(InHolder);
+
+	return NumActiveHolders < GetMaxTokens(InTokenType)
+		&& InCurrentTime - InTokenPool.LastGrantTime >= GetGrantInterval(InTokenType)
+		&& (!LastReleaseTime || InCurrentTime - *LastReleaseTime >= TokenSettings.HolderRegrantCooldown);
+}
+
+float UWarriorAttackTokenSubsystem::GetGrantInterval(EWarriorAttackTokenType InTokenType) const
+{
+	return InTokenType == EWarriorAttackTokenType::Melee ? TokenSettings.MeleeGrantInterval : TokenSettings.RangedGrantInterval;
+}
+
+void UWarriorAttackTokenSubsystem::ReclaimExpiredTokens(FAttackTokenPool& InTokenPool, double InCurrentTime)
+{
+	if (TokenSettings.TokenTimeout <= 0.f)
+	{
+		return;
+	}
+
+	for (int32 HolderIndex = InTokenPool.Holders.Num() - 1; HolderIndex >= 0; HolderIndex--)
+	{
+		const FAttackTokenHolder& Holder = InTokenPool.Holders[HolderIndex];
+
+		if (InCurrentTime - Holder.GrantTime < TokenSettings.TokenTimeout)
+		{
+			continue;
+		}
+
+		InTokenPool.ReleaseTimes.Add(Holder.Holder, InCurrentTime);
+		InTokenPool.Holders.RemoveAtSwap(HolderIndex, 1, EAllowShrinking::No);
+
+		TokenStats.TokensReclaimed++;
+	}
+
+	SET_DWORD_STAT(STAT_WarriorActiveMeleeTokens, TokenPools[static_cast<int32>(EWarriorAttackTokenType::Melee)].Holders.Num());
+	SET_DWORD_STAT(STAT_WarriorActiveRangedTokens, TokenPools[static_cast<int32>(EWarriorAttackTokenType::Ranged)].Holders.Num());
+}
+
+void UWarriorAttackTokenSubsystem::RecordWaitTime(double InWaitTime)
+{
+	TotalWaitTime += InWaitTime;
+	NumWaitedGrants++;
+
+	TokenStats.MaxWaitTime = FMath::Max(TokenStats.MaxWaitTime, static_cast<float>(InWaitTime));
+	TokenStats.AverageWaitTime = static_cast<float>(TotalWaitTime / NumWaitedGrants);
+}
+
+void UWarriorAttackTokenSubsystem::OnEnemyUnregistered(AWarriorEnemyCharacter* InEnemy, bool bWasWaveEnemy)
+{
+	const TObjectKey<AActor> HolderKey(InEnemy);
+
+	for (int32 TokenTypeIndex = 0; TokenTypeIndex < UE_ARRAY_COUNT(TokenPools); TokenTypeIndex++)
+	{
+		ReleaseAttackToken(InEnemy, static_cast<EWarriorAttackTokenType>(TokenTypeIndex));
+
+		// 被回收的敌人再次从对象池取出时视为新的敌人
+		TokenPools[TokenTypeIndex].ReleaseTimes.Remove(HolderKey);
+	}
+}
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorBehaviorTreeTickSubsystem.h"
+
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Components/WarriorBehaviorTreeComponent.h"
+#include "Controllers/WarriorAIController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Evaluate Behavior Tree Buckets"), STAT_WarriorEvaluateBehaviorTreeBuckets, STATGROUP_WarriorSurvival);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Behavior Tree Tick (ms)"), STAT_WarriorBehaviorTreeTickMs, STATGROUP_WarriorSurvival);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Behavior Tree Bucket Spread (ms)"), STAT_WarriorBehaviorTreeBucketSpreadMs, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Per Frame Behavior Trees"), STAT_WarriorPerFrameBehaviorTrees, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Bucketed Behavior Trees"), STAT_WarriorBucketedBehaviorTrees, STATGROUP_WarriorSurvival);
+
+void UWarriorBehaviorTreeTickSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		TickSettings = BaseGameMode->GetBehaviorTreeTickSettings();
+	}
+
+	BucketAverageMs.Init(0.f, FMath::Max(TickSettings.NumTickBuckets, 1));
+}
+
+void UWarriorBehaviorTreeTickSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// 行为树组件在各 TickGroup 中更新，这里已经收集到本帧的全部耗时
+	if (!BucketAverageMs.IsEmpty())
+	{
+		const float FrameTickMs = static_cast<float>(FrameTickSeconds * 1000.0);
+		float& ActiveBucketAverageMs = BucketAverageMs[GetActiveTickBucket()];
+
+		ActiveBucketAverageMs = FMath::Lerp(ActiveBucketAverageMs, FrameTickMs, TickSettings.BucketTimeSmoothingAlpha);
+
+		float MinBucketAverageMs = BucketAverageMs[0];
+		float MaxBucketAverageMs = BucketAverageMs[0];
+
+		for (const float BucketMs : BucketAverageMs)
+		{
+			MinBucketAverageMs = FMath::Min(MinBucketAverageMs, BucketMs);
+			MaxBucketAverageMs = FMath::Max(MaxBucketAverageMs, BucketMs);
+		}
+
+		SET_FLOAT_STAT(STAT_WarriorBehaviorTreeTickMs, FrameTickMs);
+		SET_FLOAT_STAT(STAT_WarriorBehaviorTreeBucketSpreadMs, MaxBucketAverageMs - MinBucketAverageMs);
+	}
+
+	LastFrameBrainTickMs = static_cast<float>(FrameTickSeconds * 1000.0);
+	FrameTickSeconds = 0.0;
+
+	TimeSinceLastEvaluation += DeltaTime;
+
+	if (TimeSinceLastEvaluation >= TickSettings.EvaluationInterval)
+	{
+		TimeSinceLastEvaluation = 0.f;
+
+		EvaluateTickBuckets();
+	}
+}
+
+TStatId UWarriorBehaviorTreeTickSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorBehaviorTreeTickSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorBehaviorTreeTickSubsystem::EvaluateTickBuckets()
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorEvaluateBehaviorTreeBuckets);
+
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+	const UWarriorAttackTokenSubsystem* AttackTokenSubsystem = GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>();
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (!EnemyRegistrySubsystem || BucketAverageMs.IsEmpty())
+	{
+		return;
+	}
+
+	const bool bStaggeredTicking = TickSettings.bEnableStaggeredTicking && UWarriorBehaviorTreeComponent::IsStaggeredTickAllowed()
+		&& BucketAverageMs.Num() > 1 && PlayerPawn;
+	const FVector PlayerLocation = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+	const float PerFrameDistanceSquared = FMath::Square(TickSettings.PerFrameDistance);
+
+	const TArray<AWarriorEnemyCharacter*>& RegisteredEnemies = EnemyRegistrySubsystem->GetRegisteredEnemies();
+	const TArray<FVector>& EnemyLocations = EnemyRegistrySubsystem->GetEnemyLocations();
+
+	int32 NumPerFrameBehaviorTrees = 0;
+	int32 NumBucketedBehaviorTrees = 0;
+
+	for (int32 RegistryIndex = 0; RegistryIndex < RegisteredEnemies.Num(); RegistryIndex++)
+	{
+		const AWarriorEnemyCharacter* Enemy = RegisteredEnemies[RegistryIndex];
+		const AWarriorAIController* WarriorAIController = IsValid(Enemy) ? Enemy->GetController<AWarriorAIController>() : nullptr;
+		UWarriorBehaviorTreeComponent* BehaviorTreeComponent = WarriorAIController ? Cast<UWarriorBehaviorTreeComponent>(WarriorAIController->GetBrainComponent()) : nullptr;
+
+		if (!BehaviorTreeComponent)
+		{
+			continue;
+		}
+
+		const bool bTickEveryFrame = !bStaggeredTicking
+			|| FVector::DistSquared(EnemyLocations[RegistryIndex], PlayerLocation) <= PerFrameDistanceSquared
+			|| (AttackTokenSubsystem && (AttackTokenSubsystem->HasAttackToken(Enemy, EWarriorAttackTokenType::Melee)
+				|| AttackTokenSubsystem->HasAttackToken(Enemy, EWarriorAttackTokenType::Ranged)));
+
+		if (bTickEveryFrame)
+		{
+			BehaviorTreeComponent->SetTickBucket(INDEX_NONE);
+			NumPerFrameBehaviorTrees++;
+		}
+		else
+		{
+			// 对象编号在敌人的整个生命周期（包括对象池中的复用）内不变，分组不会来回跳动
+			BehaviorTreeComponent->SetTickBucket(static_cast<int32>(Enemy->GetUniqueID() % static_cast<uint32>(BucketAverageMs.Num())));
+			NumBucketedBehaviorTrees++;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WarriorPerFrameBehaviorTrees, NumPerFrameBehaviorTrees);
+	SET_DWORD_STAT(STAT_WarriorBucketedBehaviorTrees, NumBucketedBehaviorTrees);
+}
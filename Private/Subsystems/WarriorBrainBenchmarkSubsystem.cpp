@@ -0,0 +1,286 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorBrainBenchmarkSubsystem.h"
+
+#include "Characters/WarriorEnemyCharacter.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "NavigationSystem.h"
+#include "Subsystems/WarriorBehaviorTreeTickSubsystem.h"
+
+bool UWarriorBrainBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Param(FCommandLine::Get(), TEXT("WarriorBrainBenchmark"));
+}
+
+void UWarriorBrainBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FString EnemyClassPath;
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorBrainBenchmarkEnemy="), EnemyClassPath);
+
+	if (!EnemyClassPath.IsEmpty())
+	{
+		EnemyClass = LoadClass<AWarriorEnemyCharacter>(nullptr, *EnemyClassPath);
+	}
+
+	FString AgentCountsString = TEXT("50,100,200");
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorBrainBenchmarkCounts="), AgentCountsString);
+
+	TArray<FString> AgentCountStrings;
+	AgentCountsString.ParseIntoArray(AgentCountStrings, TEXT(","));
+
+	for (const FString& AgentCountString : AgentCountStrings)
+	{
+		const int32 AgentCount = FCString::Atoi(*AgentCountString);
+
+		if (AgentCount > 0)
+		{
+			AgentCounts.Add(AgentCount);
+		}
+	}
+
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorBrainBenchmarkSeconds="), MeasureSeconds);
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorBrainBenchmarkWarmup="), WarmupSeconds);
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorBrainBenchmarkRadius="), SpawnRadius);
+
+	// 默认让两种大脑都每帧更新，比较的是同样更新频率下的开销
+	if (!FParse::Param(FCommandLine::Get(), TEXT("WarriorBrainBenchmarkStaggered")))
+	{
+		if (IConsoleVariable* StaggeredTickVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("warrior.StaggeredBehaviorTreeTick")))
+		{
+			StaggeredTickVariable->Set(false, ECVF_SetByCommandline);
+		}
+	}
+}
+
+bool UWarriorBrainBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UWarriorBrainBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorBrainBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorBrainBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	switch (Phase)
+	{
+		case EBenchmarkPhase::NotStarted:
+			if (!EnemyClass || AgentCounts.IsEmpty())
+			{
+				UE_LOG(LogTemp, Error, TEXT("Warrior brain benchmark needs a valid -WarriorBrainBenchmarkEnemy= class and at least one agent count"));
+				FinishBenchmark();
+			}
+			else if (UGameplayStatics::GetPlayerPawn(this, 0))
+			{
+				BeginSample();
+			}
+			break;
+
+		case EBenchmarkPhase::WarmingUp:
+			PhaseElapsedSeconds += DeltaTime;
+
+			if (PhaseElapsedSeconds >= WarmupSeconds)
+			{
+				PhaseElapsedSeconds = 0.f;
+				Phase = EBenchmarkPhase::Measuring;
+			}
+			break;
+
+		case EBenchmarkPhase::Measuring:
+			if (const UWarriorBehaviorTreeTickSubsystem* TickSubsystem = GetWorld()->GetSubsystem<UWarriorBehaviorTreeTickSubsystem>())
+			{
+				CurrentBrainTickMs.Add(TickSubsystem->GetLastFrameBrainTickMs());
+			}
+
+			CurrentFrameTimeSumMs += DeltaTime * 1000.0;
+			PhaseElapsedSeconds += DeltaTime;
+
+			if (PhaseElapsedSeconds >= MeasureSeconds)
+			{
+				EndSample();
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+void UWarriorBrainBenchmarkSubsystem::BeginSample()
+{
+	// 先测完行为树的所有数量，再测状态树
+	const int32 NumSamplesPerBrain = AgentCounts.Num();
+
+	CurrentSample = FWarriorBrainBenchmarkSample();
+	CurrentSample.BrainType = NextSampleIndex < NumSamplesPerBrain ? EWarriorEnemyBrainType::BehaviorTree : EWarriorEnemyBrainType::StateTree;
+	CurrentSample.NumAgents = AgentCounts[NextSampleIndex % NumSamplesPerBrain];
+
+	CurrentBrainTickMs.Reset();
+	CurrentFrameTimeSumMs = 0.0;
+	PhaseElapsedSeconds = 0.f;
+
+	SetBrainOverride(CurrentSample.BrainType);
+	SpawnAgents(CurrentSample.NumAgents);
+
+	Phase = EBenchmarkPhase::WarmingUp;
+
+	UE_LOG(LogTemp, Display, TEXT("Warrior brain benchmark: %s with %i agents"),
+		*UEnum::GetValueAsString(CurrentSample.BrainType), CurrentSample.NumAgents);
+}
+
+void UWarriorBrainBenchmarkSubsystem::EndSample()
+{
+	DestroyAgents();
+
+	CurrentBrainTickMs.Sort();
+
+	double BrainTickSumMs = 0.0;
+
+	for (const float BrainTickMs : CurrentBrainTickMs)
+	{
+		BrainTickSumMs += BrainTickMs;
+	}
+
+	CurrentSample.NumFrames = CurrentBrainTickMs.Num();
+
+	if (CurrentSample.NumFrames > 0)
+	{
+		CurrentSample.BrainTickMeanMs = static_cast<float>(BrainTickSumMs / CurrentSample.NumFrames);
+		CurrentSample.BrainTickP95Ms = CurrentBrainTickMs[FMath::Clamp(FMath::CeilToInt(0.95f * CurrentSample.NumFrames) - 1, 0, CurrentSample.NumFrames - 1)];
+		CurrentSample.PerAgentMicroseconds = CurrentSample.BrainTickMeanMs * 1000.f / CurrentSample.NumAgents;
+		CurrentSample.FrameTimeMeanMs = static_cast<float>(CurrentFrameTimeSumMs / CurrentSample.NumFrames);
+	}
+
+	Samples.Add(CurrentSample);
+
+	UE_LOG(LogTemp, Display, TEXT("Warrior brain benchmark: %s x%i, brain mean %.3fms, p95 %.3fms, %.2fus per agent"),
+		*UEnum::GetValueAsString(CurrentSample.BrainType), CurrentSample.NumAgents, CurrentSample.BrainTickMeanMs,
+		CurrentSample.BrainTickP95Ms, CurrentSample.PerAgentMicroseconds);
+
+	NextSampleIndex++;
+
+	if (NextSampleIndex >= AgentCounts.Num() * 2)
+	{
+		FinishBenchmark();
+	}
+	else
+	{
+		BeginSample();
+	}
+}
+
+void UWarriorBrainBenchmarkSubsystem::SpawnAgents(int32 InNumAgents)
+{
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	const UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!PlayerPawn)
+	{
+		return;
+	}
+
+	const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	SpawnedAgents.Reserve(InNumAgents);
+
+	for (int32 AgentIndex = 0; AgentIndex < InNumAgents; AgentIndex++)
+	{
+		// 均匀分布在玩家周围的圆环上，半径交替变化以免挤在一起
+		const float Angle = 2.f * PI * AgentIndex / InNumAgents;
+		const float Radius = SpawnRadius * (AgentIndex % 2 == 0 ? 1.f : 0.75f);
+
+		FVector SpawnLocation = PlayerLocation + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * Radius;
+		FNavLocation NavLocation;
+
+		if (NavigationSystem && NavigationSystem->ProjectPointToNavigation(SpawnLocation, NavLocation))
+		{
+			SpawnLocation = NavLocation.Location + FVector(0.f, 0.f, 100.f);
+		}
+
+		const FRotator SpawnRotation = (PlayerLocation - SpawnLocation).GetSafeNormal2D().Rotation();
+
+		if (AWarriorEnemyCharacter* SpawnedAgent = GetWorld()->SpawnActor<AWarriorEnemyCharacter>(EnemyClass, SpawnLocation, SpawnRotation, SpawnParameters))
+		{
+			SpawnedAgents.Add(SpawnedAgent);
+		}
+	}
+}
+
+void UWarriorBrainBenchmarkSubsystem::DestroyAgents()
+{
+	for (AWarriorEnemyCharacter* SpawnedAgent : SpawnedAgents)
+	{
+		if (!IsValid(SpawnedAgent))
+		{
+			continue;
+		}
+
+		if (AController* AgentController = SpawnedAgent->GetController())
+		{
+			AgentController->Destroy();
+		}
+
+		SpawnedAgent->Destroy();
+	}
+
+	SpawnedAgents.Reset();
+}
+
+void UWarriorBrainBenchmarkSubsystem::FinishBenchmark()
+{
+	Phase = EBenchmarkPhase::Finished;
+
+	DestroyAgents();
+
+	if (IConsoleVariable* BrainOverrideVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("warrior.EnemyBrainOverride")))
+	{
+		BrainOverrideVariable->Set(0, ECVF_SetByCode);
+	}
+
+	WriteReport();
+
+	if (GetWorld()->WorldType == EWorldType::Game)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, Samples.Num() == AgentCounts.Num() * 2 ? 0 : 1);
+	}
+}
+
+void UWarriorBrainBenchmarkSubsystem::WriteReport() const
+{
+	FString CsvReport = TEXT("BrainType,NumAgents,NumFrames,BrainTickMeanMs,BrainTickP95Ms,PerAgentMicroseconds,FrameTimeMeanMs\n");
+
+	for (const FWarriorBrainBenchmarkSample& Sample : Samples)
+	{
+		CsvReport += FString::Printf(TEXT("%s,%i,%i,%.4f,%.4f,%.3f,%.3f\n"),
+			Sample.BrainType == EWarriorEnemyBrainType::StateTree ? TEXT("StateTree") : TEXT("BehaviorTree"),
+			Sample.NumAgents, Sample.NumFrames, Sample.BrainTickMeanMs, Sample.BrainTickP95Ms, Sample.PerAgentMicroseconds, Sample.FrameTimeMeanMs);
+	}
+
+	const FString CsvFilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("WarriorBrainBenchmark"),
+		FString::Printf(TEXT("BrainBenchmark_%s_%s.csv"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString()));
+
+	FFileHelper::SaveStringToFile(CsvReport, *CsvFilePath);
+
+	UE_LOG(LogTemp, Display, TEXT("Warrior brain benchmark report written to %s"), *CsvFilePath);
+}
+
+void UWarriorBrainBenchmarkSubsystem::SetBrainOverride(EWarriorEnemyBrainType InBrainType)
+{
+	if (IConsoleVariable* BrainOverrideVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("warrior.EnemyBrainOverride")))
+	{
+		BrainOverrideVariable->Set(InBrainType == EWarriorEnemyBrainType::StateTree ? 2 : 1, ECVF_SetByCode);
+	}
+}
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorCrowdAvoidanceSubsystem.h"
+
+#include "AI/WarriorCrowdManager.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Controllers/WarriorAIController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Evaluate Crowd Avoidance"), STAT_WarriorEvaluateCrowdAvoidance, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("High Avoidance Enemies"), STAT_WarriorHighAvoidanceEnemies, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Medium Avoidance Enemies"), STAT_WarriorMediumAvoidanceEnemies, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Low Avoidance Enemies"), STAT_WarriorLowAvoidanceEnemies, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Obstacle Only Enemies"), STAT_WarriorObstacleOnlyEnemies, STATGROUP_WarriorSurvival);
+
+void UWarriorCrowdAvoidanceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		CrowdAvoidanceSettings = BaseGameMode->GetCrowdAvoidanceSettings();
+	}
+
+	CrowdAvoidanceSettings.MediumLevelDistance = FMath::Max(CrowdAvoidanceSettings.MediumLevelDistance, CrowdAvoidanceSettings.HighLevelDistance);
+	CrowdAvoidanceSettings.LowLevelDistance = FMath::Max(CrowdAvoidanceSettings.LowLevelDistance, CrowdAvoidanceSettings.MediumLevelDistance);
+}
+
+void UWarriorCrowdAvoidanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastEvaluation += DeltaTime;
+
+	if (TimeSinceLastEvaluation >= CrowdAvoidanceSettings.EvaluationInterval)
+	{
+		TimeSinceLastEvaluation = 0.f;
+
+		EvaluateCrowdAvoidance();
+	}
+}
+
+TStatId UWarriorCrowdAvoidanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorCrowdAvoidanceSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorCrowdAvoidanceSubsystem::EvaluateCrowdAvoidance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorEvaluateCrowdAvoidance);
+
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (!EnemyRegistrySubsystem || !PlayerPawn)
+	{
+		return;
+	}
+
+	const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+
+	const TArray<AWarriorEnemyCharacter*>& RegisteredEnemies = EnemyRegistrySubsystem->GetRegisteredEnemies();
+	const TArray<FVector>& EnemyLocations = EnemyRegistrySubsystem->GetEnemyLocations();
+
+	// 先统计每格的存活敌人数量，之后每个敌人只需读取周围 3x3 格
+	EnemyCountByCell.Reset();
+
+	if (CrowdAvoidanceSettings.bEnableDynamicCrowdAvoidance)
+	{
+		for (int32 RegistryIndex = 0; RegistryIndex < RegisteredEnemies.Num(); RegistryIndex++)
+		{
+			if (!EnemyRegistrySubsystem->IsEnemyDeadAt(RegistryIndex))
+			{
+				EnemyCountByCell.FindOrAdd(GetDensityCell(EnemyLocations[RegistryIndex]))++;
+			}
+		}
+	}
+
+	FMemory::Memzero(NumEnemiesPerLevel);
+
+	for (int32 RegistryIndex = 0; RegistryIndex < RegisteredEnemies.Num(); RegistryIndex++)
+	{
+		const AWarriorEnemyCharacter* Enemy = RegisteredEnemies[RegistryIndex];
+		AWarriorAIController* WarriorAIController = IsValid(Enemy) ? Enemy->GetController<AWarriorAIController>() : nullptr;
+
+		if (!WarriorAIController || EnemyRegistrySubsystem->IsEnemyDeadAt(RegistryIndex))
+		{
+			continue;
+		}
+
+		EWarriorCrowdAvoidanceLevel Level = EWarriorCrowdAvoidanceLevel::High;
+
+		if (CrowdAvoidanceSettings.bEnableDynamicCrowdAvoidance)
+		{
+			const FVector& EnemyLocation = EnemyLocations[RegistryIndex];
+
+			Level = GetLevelForDistance(FVector::DistSquared(EnemyLocation, PlayerLocation));
+
+			if (Level == EWarriorCrowdAvoidanceLevel::Medium || Level == EWarriorCrowdAvoidanceLevel::Low)
+			{
+				const FIntPoint Cell = GetDensityCell(EnemyLocation);
+
+				// 不计入自己
+				int32 NumNeighbors = -1;
+
+				for (int32 OffsetX = -1; OffsetX <= 1; OffsetX++)
+				{
+					for (int32 OffsetY = -1; OffsetY <= 1; OffsetY++)
+					{
+						if (const int32* EnemyCount = EnemyCountByCell.Find(Cell + FIntPoint(OffsetX, OffsetY)))
+						{
+							NumNeighbors += *EnemyCount;
+						}
+					}
+				}
+
+				if (Level == EWarriorCrowdAvoidanceLevel::Medium && NumNeighbors < CrowdAvoidanceSettings.SparseNeighborCount)
+				{
+					Level = EWarriorCrowdAvoidanceLevel::Low;
+				}
+				else if (Level == EWarriorCrowdAvoidanceLevel::Low && NumNeighbors >= CrowdAvoidanceSettings.DenseNeighborCount)
+				{
+					Level = EWarriorCrowdAvoidanceLevel::Medium;
+				}
+			}
+		}
+
+		WarriorAIController->SetCrowdAvoidanceLevel(Level);
+
+		NumEnemiesPerLevel[static_cast<int32>(Level)]++;
+	}
+
+	SET_DWORD_STAT(STAT_WarriorHighAvoidanceEnemies, NumEnemiesPerLevel[static_cast<int32>(EWarriorCrowdAvoidanceLevel::High)]);
+	SET_DWORD_STAT(STAT_WarriorMediumAvoidanceEnemies, NumEnemiesPerLevel[static_cast<int32>(EWarriorCrowdAvoidanceLevel::Medium)]);
+	SET_DWORD_STAT(STAT_WarriorLowAvoidanceEnemies, NumEnemiesPerLevel[static_cast<int32>(EWarriorCrowdAvoidanceLevel::Low)]);
+	SET_DWORD_STAT(STAT_WarriorObstacleOnlyEnemies, NumEnemiesPerLevel[static_cast<int32>(EWarriorCrowdAvoidanceLevel::Off)]);
+}
+
+float UWarriorCrowdAvoidanceSubsystem::GetCrowdSimulationTimeMs() const
+{
+	const UWarriorCrowdManager* CrowdManager = Cast<UWarriorCrowdManager>(UCrowdManager::GetCurrent(GetWorld()));
+
+	return CrowdManager ? CrowdManager->GetLastSimulationTimeMs() : 0.f;
+}
+
+EWarriorCrowdAvoidanceLevel UWarriorCrowdAvoidanceSubsystem::GetLevelForDistance(float InDistanceSquared) const
+{
+	if (InDistanceSquared <= FMath::Square(CrowdAvoidanceSettings.HighLevelDistance))
+	{
+		return EWarriorCrowdAvoidanceLevel::High;
+	}
+
+	if (InDistanceSquared <= FMath::Square(CrowdAvoidanceSettings.MediumLevelDistance))
+	{
+		return EWarriorCrowdAvoidanceLevel::Medium;
+	}
+
+	if (InDistanceSquared <= FMath::Square(CrowdAvoidanceSettings.LowLevelDistance))
+	{
+		return EWarriorCrowdAvoidanceLevel::Low;
+	}
+
+	return EWarriorCrowdAvoidanceLevel::Off;
+}
@@ -0,0 +1,547 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorEnemyCrowdSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+#include "Subsystems/WarriorEnemyPoolSubsystem.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "Subsystems/WarriorPopulationDirectorSubsystem.h"
+#include "Subsystems/WarriorSpawnPointSubsystem.h"
+#include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Update Crowd Steering"), STAT_WarriorUpdateCrowdSteering, STATGROUP_WarriorSurvival);
+DECLARE_CYCLE_STAT(TEXT("Evaluate Enemy Crowd"), STAT_WarriorEvaluateEnemyCrowd, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Entities"), STAT_WarriorCrowdEntities, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Promotions"), STAT_WarriorCrowdPromotions, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Demotions"), STAT_WarriorCrowdDemotions, STATGROUP_WarriorSurvival);
+
+void UWarriorEnemyCrowdSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		CrowdSettings = BaseGameMode->GetEnemyCrowdSettings();
+	}
+
+	CrowdSettings.DemotionRadius = FMath::Max(CrowdSettings.DemotionRadius, CrowdSettings.EngagementRadius);
+
+	SeparationCellSize = FMath::Max(CrowdSettings.SeparationRadius, 50.f);
+}
+
+void UWarriorEnemyCrowdSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!CrowdSettings.bEnableCrowdTier)
+	{
+		return;
+	}
+
+	TimeSinceLastEvaluation += DeltaTime;
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (PlayerPawn && TimeSinceLastEvaluation >= CrowdSettings.EvaluationInterval)
+	{
+		TimeSinceLastEvaluation = 0.f;
+
+		SCOPE_CYCLE_COUNTER(STAT_WarriorEvaluateEnemyCrowd);
+
+		const FVector HeroLocation = PlayerPawn->GetActorLocation();
+
+		// 目前所有实体都以玩家为目标
+		for (FVector& TargetLocation : EntityTargetLocations)
+		{
+			TargetLocation = HeroLocation;
+		}
+
+		SnapEntitiesToNavigation();
+		UpdateSeparation();
+
+		// 先降级腾出同时存活名额，再提升
+		DemoteEnemies(HeroLocation);
+		PromoteEntities(HeroLocation);
+	}
+
+	UpdateSteering(DeltaTime);
+	UpdateProxyInstances();
+
+	SET_DWORD_STAT(STAT_WarriorCrowdEntities, EntityLocations.Num());
+}
+
+TStatId UWarriorEnemyCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorEnemyCrowdSubsystem, STATGROUP_Tickables);
+}
+
+bool UWarriorEnemyCrowdSubsystem::ShouldSpawnAsCrowdEntity(const FVector& InGroundLocation) const
+{
+	if (!CrowdSettings.bEnableCrowdTier)
+	{
+		return false;
+	}
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	return PlayerPawn && FVector::DistSquared2D(InGroundLocation, PlayerPawn->GetActorLocation()) > FMath::Square(CrowdSettings.EngagementRadius);
+}
+
+void UWarriorEnemyCrowdSubsystem::AddCrowdEntity(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, UClass* InLoadedEnemyClass,
+	const FVector& InGroundLocation)
+{
+	AddEntity(InSoftEnemyClass, InLoadedEnemyClass, InGroundLocation, 1.f);
+
+	CrowdStats.SpawnedAsCrowdEntities++;
+}
+
+int32 UWarriorEnemyCrowdSubsystem::AddEntity(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, UClass* InLoadedEnemyClass,
+	const FVector& InGroundLocation, float InHealthPercent)
+{
+	const int32 ClassIndex = FindOrAddCrowdEnemyClass(InSoftEnemyClass, InLoadedEnemyClass);
+
+	const int32 EntityIndex = EntityLocations.Add(InGroundLocation);
+	EntityVelocities.Add(FVector::ZeroVector);
+	EntitySeparations.Add(FVector::ZeroVector);
+	EntityHealthPercents.Add(FMath::Clamp(InHealthPercent, KINDA_SMALL_NUMBER, 1.f));
+	EntityClassIndices.Add(ClassIndex);
+
+	// 目标在下一次检查时更新，在此之前原地等待
+	EntityTargetLocations.Add(InGroundLocation);
+	EntityNavLocations.Add(InGroundLocation);
+
+	CrowdStats.MaxCrowdEntities = FMath::Max(CrowdStats.MaxCrowdEntities, EntityLocations.Num());
+
+	return EntityIndex;
+}
+
+void UWarriorEnemyCrowdSubsystem::RemoveEntityAt(int32 InEntityIndex)
+{
+	EntityLocations.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityVelocities.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntitySeparations.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityHealthPercents.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityClassIndices.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityTargetLocations.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityNavLocations.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+}
+
+int32 UWarriorEnemyCrowdSubsystem::FindOrAddCrowdEnemyClass(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, UClass* InLoadedEnemyClass)
+{
+	for (int32 ClassIndex = 0; ClassIndex < CrowdEnemyClasses.Num(); ClassIndex++)
+	{
+		if (CrowdEnemyClasses[ClassIndex].SoftEnemyClass == InSoftEnemyClass)
+		{
+			return ClassIndex;
+		}
+	}
+
+	FWarriorCrowdEnemyClass& CrowdEnemyClass = CrowdEnemyClasses.AddDefaulted_GetRef();
+	CrowdEnemyClass.SoftEnemyClass = InSoftEnemyClass;
+	CrowdEnemyClass.LoadedEnemyClass = InLoadedEnemyClass;
+
+	const AWarriorEnemyCharacter* EnemyCDO = InLoadedEnemyClass ? InLoadedEnemyClass->GetDefaultObject<AWarriorEnemyCharacter>() : nullptr;
+
+	if (!EnemyCDO)
+	{
+		return CrowdEnemyClasses.Num() - 1;
+	}
+
+	CrowdEnemyClass.MaxSpeed = EnemyCDO->GetCharacterMovement()->MaxWalkSpeed;
+
+	if (UStaticMesh* CrowdProxyMesh = EnemyCDO->GetCrowdProxyMesh())
+	{
+		if (!ProxyMeshActor)
+		{
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.ObjectFlags |= RF_Transient;
+
+			ProxyMeshActor = GetWorld()->SpawnActor<AActor>(SpawnParameters);
+
+			USceneComponent* ProxyRootComponent = NewObject<USceneComponent>(ProxyMeshActor, TEXT("CrowdProxyRoot"));
+			ProxyRootComponent->SetMobility(EComponentMobility::Movable);
+			ProxyMeshActor->SetRootComponent(ProxyRootComponent);
+			ProxyRootComponent->RegisterComponent();
+		}
+
+		// 实例每帧以世界坐标整体更新，不参与碰撞、导航与阴影
+		UInstancedStaticMeshComponent* ProxyMeshComponent = NewObject<UInstancedStaticMeshComponent>(ProxyMeshActor);
+		ProxyMeshComponent->SetMobility(EComponentMobility::Movable);
+		ProxyMeshComponent->SetStaticMesh(CrowdProxyMesh);
+		ProxyMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		ProxyMeshComponent->SetCanEverAffectNavigation(false);
+		ProxyMeshComponent->SetCastShadow(false);
+		ProxyMeshComponent->SetupAttachment(ProxyMeshActor->GetRootComponent());
+		ProxyMeshComponent->RegisterComponent();
+
+		CrowdEnemyClass.ProxyMeshComponent = ProxyMeshComponent;
+	}
+
+	return CrowdEnemyClasses.Num() - 1;
+}
+
+void UWarriorEnemyCrowdSubsystem::UpdateSteering(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorUpdateCrowdSteering);
+
+	const float EngagementRadiusSquared = FMath::Square(CrowdSettings.EngagementRadius);
+	const float BlendAlpha = FMath::Clamp(DeltaTime * CrowdSettings.SteeringResponsiveness, 0.f, 1.f);
+
+	for (int32 EntityIndex = 0; EntityIndex < EntityLocations.Num(); EntityIndex++)
+	{
+		const float MaxSpeed = CrowdEnemyClasses[EntityClassIndices[EntityIndex]].MaxSpeed;
+
+		const FVector ToTarget = (EntityTargetLocations[EntityIndex] - EntityLocations[EntityIndex]) * FVector(1.f, 1.f, 0.f);
+		const float DistanceSquared = ToTarget.SizeSquared();
+
+		// 进入交战半径后停下等待提升，同时存活名额已满时不会继续靠近
+		FVector DesiredVelocity = DistanceSquared > EngagementRadiusSquared
+			? ToTarget * (MaxSpeed * FMath::InvSqrt(DistanceSquared))
+			: FVector::ZeroVector;
+
+		DesiredVelocity += EntitySeparations[EntityIndex] * (MaxSpeed * CrowdSettings.SeparationWeight);
+		DesiredVelocity = DesiredVelocity.GetClampedToMaxSize(MaxSpeed);
+
+		EntityVelocities[EntityIndex] = FMath::Lerp(EntityVelocities[EntityIndex], DesiredVelocity, BlendAlpha);
+		EntityLocations[EntityIndex] += EntityVelocities[EntityIndex] * DeltaTime;
+	}
+}
+
+void UWarriorEnemyCrowdSubsystem::UpdateSeparation()
+{
+	// 先按格子分桶，之后每个实体只需检查周围 3x3 格
+	EntitiesByCell.Reset();
+
+	for (int32 EntityIndex = 0; EntityIndex < EntityLocations.Num(); EntityIndex++)
+	{
+		EntitiesByCell.FindOrAdd(GetSeparationCell(EntityLocations[EntityIndex])).Add(EntityIndex);
+	}
+
+	const float SeparationRadius = CrowdSettings.SeparationRadius;
+	const float SeparationRadiusSquared = FMath::Square(SeparationRadius);
+
+	for (int32 EntityIndex = 0; EntityIndex < EntityLocations.Num(); EntityIndex++)
+	{
+		const FVector& EntityLocation = EntityLocations[EntityIndex];
+		const FIntPoint EntityCell = GetSeparationCell(EntityLocation);
+
+		FVector Separation = FVector::ZeroVector;
+
+		for (int32 OffsetX = -1; OffsetX <= 1; OffsetX++)
+		{
+			for (int32 OffsetY = -1; OffsetY <= 1; OffsetY++)
+			{
+				const TArray<int32>* NeighborIndices = EntitiesByCell.Find(EntityCell + FIntPoint(OffsetX, OffsetY));
+
+				if (!NeighborIndices)
+				{
+					continue;
+				}
+
+				for (const int32 NeighborIndex : *NeighborIndices)
+				{
+					if (NeighborIndex == EntityIndex)
+					{
+						continue;
+					}
+
+					const FVector Away = (EntityLocation - EntityLocations[NeighborIndex]) * FVector(1.f, 1.f, 0.f);
+					const float DistanceSquared = Away.SizeSquared();
+
+					if (DistanceSquared >= SeparationRadiusSquared)
+					{
+						continue;
+					}
+
+					// 从同一个刷怪点生成的实体可能完全重合，按下标固定推开的方向
+					if (DistanceSquared <= KINDA_SMALL_NUMBER)
+					{
+						Separation.X += EntityIndex < NeighborIndex ? 1.f : -1.f;
+						continue;
+					}
+
+					const float Distance = FMath::Sqrt(DistanceSquared);
+
+					// 越近推力越大，刚好贴合时为单位长度
+					Separation += Away * ((SeparationRadius - Distance) / (SeparationRadius * Distance));
+				}
+			}
+		}
+
+		EntitySeparations[EntityIndex] = Separation.GetClampedToMaxSize(1.f);
+	}
+}
+
+void UWarriorEnemyCrowdSubsystem::SnapEntitiesToNavigation()
+{
+	const UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!NavigationSystem)
+	{
+		return;
+	}
+
+	const FVector ProjectExtent(50.f, 50.f, 500.f);
+
+	for (int32 EntityIndex = 0; EntityIndex < EntityLocations.Num(); EntityIndex++)
+	{
+		FVector& EntityLocation = EntityLocations[EntityIndex];
+		FNavLocation NavLocation;
+		FVector RaycastHitLocation;
+
+		// 投影只能发现离开了导航网格，走下悬崖时投影会落到下方的地面，需要再沿导航网格检查两点之间是否连通
+		const bool bOnNavigation = NavigationSystem->ProjectPointToNavigation(EntityLocation, NavLocation, ProjectExtent)
+			&& !UNavigationSystemV1::NavigationRaycast(this, EntityNavLocations[EntityIndex], NavLocation.Location, RaycastHitLocation);
+
+		if (bOnNavigation)
+		{
+			EntityLocation.Z = NavLocation.Location.Z;
+			EntityNavLocations[EntityIndex] = EntityLocation;
+		}
+		else
+		{
+			EntityLocation = EntityNavLocations[EntityIndex];
+			EntityVelocities[EntityIndex] = FVector::ZeroVector;
+		}
+	}
+}
+
+void UWarriorEnemyCrowdSubsystem::UpdateProxyInstances()
+{
+	for (FWarriorCrowdEnemyClass& CrowdEnemyClass : CrowdEnemyClasses)
+	{
+		CrowdEnemyClass.InstanceTransforms.Reset();
+	}
+
+	for (int32 EntityIndex = 0; EntityIndex < EntityLocations.Num(); EntityIndex++)
+	{
+		FWarriorCrowdEnemyClass& CrowdEnemyClass = CrowdEnemyClasses[EntityClassIndices[EntityIndex]];
+
+		if (!CrowdEnemyClass.ProxyMeshComponent)
+		{
+			continue;
+		}
+
+		// 移动时朝向速度方向，停下时朝向目标
+		const FVector& EntityVelocity = EntityVelocities[EntityIndex];
+		const FVector FacingDirection = EntityVelocity.SizeSquared2D() > 1.f ? EntityVelocity : EntityTargetLocations[EntityIndex] - EntityLocations[EntityIndex];
+
+		CrowdEnemyClass.InstanceTransforms.Emplace(FRotator(0.f, FacingDirection.Rotation().Yaw, 0.f), EntityLocations[EntityIndex]);
+	}
+
+	for (FWarriorCrowdEnemyClass& CrowdEnemyClass : CrowdEnemyClasses)
+	{
+		UInstancedStaticMeshComponent* ProxyMeshComponent = CrowdEnemyClass.ProxyMeshComponent;
+
+		if (!ProxyMeshComponent)
+		{
+			continue;
+		}
+
+		// 数量不变时原地更新全部实例，数量变化时整体重建
+		if (ProxyMeshComponent->GetInstanceCount() == CrowdEnemyClass.InstanceTransforms.Num())
+		{
+			if (!CrowdEnemyClass.InstanceTransforms.IsEmpty())
+			{
+				ProxyMeshComponent->BatchUpdateInstancesTransforms(0, CrowdEnemyClass.InstanceTransforms, true, true, true);
+			}
+		}
+		else
+		{
+			ProxyMeshComponent->ClearInstances();
+			ProxyMeshComponent->AddInstances(CrowdEnemyClass.InstanceTransforms, false, true, false);
+		}
+	}
+}
+
+void UWarriorEnemyCrowdSubsystem::PromoteEntities(const FVector& InHeroLocation)
+{
+	UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>();
+	UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+	const UWarriorPopulationDirectorSubsystem* PopulationDirectorSubsystem = GetWorld()->GetSubsystem<UWarriorPopulationDirectorSubsystem>();
+	const UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!EnemyPoolSubsystem || !EnemyRegistrySubsystem)
+	{
+		return;
+	}
+
+	const float EngagementRadiusSquared = FMath::Square(CrowdSettings.EngagementRadius);
+
+	PromotionCandidates.Reset();
+
+	for (int32 EntityIndex = 0; EntityIndex < EntityLocations.Num(); EntityIndex++)
+	{
+		const float DistanceSquared = FVector::DistSquared2D(EntityLocations[EntityIndex], InHeroLocation);
+
+		if (DistanceSquared <= EngagementRadiusSquared)
+		{
+			PromotionCandidates.Emplace(DistanceSquared, EntityIndex);
+		}
+	}
+
+	if (PromotionCandidates.IsEmpty())
+	{
+		return;
+	}
+
+	// 离玩家最近的实体优先提升
+	PromotionCandidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	TArray<int32, TInlineAllocator<8>> PromotedEntityIndices;
+
+	const int32 NumCandidatesToTry = FMath::Min(PromotionCandidates.Num(), CrowdSettings.MaxPromotionsPerEvaluation);
+
+	for (int32 CandidateIndex = 0; CandidateIndex < NumCandidatesToTry; CandidateIndex++)
+	{
+		// 提升同样受同时存活上限约束，名额不足的实体留在原地等待
+		if (PopulationDirectorSubsystem && EnemyRegistrySubsystem->GetNumWaveEnemies() >= PopulationDirectorSubsystem->GetConcurrentEnemyCap())
+		{
+			break;
+		}
+
+		const int32 EntityIndex = PromotionCandidates[CandidateIndex].Value;
+		const FWarriorCrowdEnemyClass& CrowdEnemyClass = CrowdEnemyClasses[EntityClassIndices[EntityIndex]];
+
+		FVector GroundLocation = EntityLocations[EntityIndex];
+
+		// 投影失败的实体留在群体中，等下次贴合退回导航网格后再提升，不在导航网格外生成角色
+		if (NavigationSystem)
+		{
+			FNavLocation NavLocation;
+
+			if (!NavigationSystem->ProjectPointToNavigation(GroundLocation, NavLocation, FVector(50.f, 50.f, 500.f)))
+			{
+				CrowdStats.FailedPromotions++;
+				continue;
+			}
+
+			GroundLocation = NavLocation.Location;
+		}
+
+		const FVector SpawnLocation = UWarriorSpawnPointSubsystem::GetSpawnLocationForEnemyClass(GroundLocation, CrowdEnemyClass.LoadedEnemyClass);
+		const FRotator SpawnRotation = (InHeroLocation - GroundLocation).GetSafeNormal2D().Rotation();
+
+		AWarriorEnemyCharacter* PromotedEnemy = EnemyPoolSubsystem->AcquireEnemy(CrowdEnemyClass.SoftEnemyClass, CrowdEnemyClass.LoadedEnemyClass,
+			SpawnLocation, SpawnRotation);
+
+		if (!PromotedEnemy)
+		{
+			CrowdStats.FailedPromotions++;
+			continue;
+		}
+
+		PromotedEnemy->SetPendingHealthPercent(EntityHealthPercents[EntityIndex]);
+
+		// 先计入波次再移除实体，波次存活数量在整个过程中保持不变
+		EnemyRegistrySubsystem->MarkEnemyAsWaveEnemy(PromotedEnemy);
+
+		PromotedEntityIndices.Add(EntityIndex);
+
+		CrowdStats.Promotions++;
+		INC_DWORD_STAT(STAT_WarriorCrowdPromotions);
+	}
+
+	// 从大到小移除，交换删除不会影响尚未移除的下标
+	PromotedEntityIndices.Sort(TGreater<int32>());
+
+	for (const int32 EntityIndex : PromotedEntityIndices)
+	{
+		RemoveEntityAt(EntityIndex);
+	}
+}
+
+void UWarriorEnemyCrowdSubsystem::DemoteEnemies(const FVector& InHeroLocation)
+{
+	UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+	UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>();
+	const UWarriorAttackTokenSubsystem* AttackTokenSubsystem = GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>();
+
+	if (!EnemyRegistrySubsystem || CrowdSettings.MaxDemotionsPerEvaluation <= 0)
+	{
+		return;
+	}
+
+	const float DemotionRadiusSquared = FMath::Square(CrowdSettings.DemotionRadius);
+
+	const TArray<AWarriorEnemyCharacter*>& RegisteredEnemies = EnemyRegistrySubsystem->GetRegisteredEnemies();
+	const TArray<FVector>& EnemyLocations = EnemyRegistrySubsystem->GetEnemyLocations();
+
+	// 回收会修改登记表，先收集再处理
+	DemotionCandidates.Reset();
+
+	for (int32 RegistryIndex = 0; RegistryIndex < RegisteredEnemies.Num(); RegistryIndex++)
+	{
+		if (!EnemyRegistrySubsystem->IsWaveEnemyAt(RegistryIndex) || EnemyRegistrySubsystem->IsEnemyDeadAt(RegistryIndex))
+		{
+			continue;
+		}
+
+		if (FVector::DistSquared2D(EnemyLocations[RegistryIndex], InHeroLocation) <= DemotionRadiusSquared)
+		{
+			continue;
+		}
+
+		AWarriorEnemyCharacter* Enemy = RegisteredEnemies[RegistryIndex];
+
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		// 持有攻击名额或正在受击的敌人保持完整角色
+		if (AttackTokenSubsystem && (AttackTokenSubsystem->HasAttackToken(Enemy, EWarriorAttackTokenType::Melee)
+			|| AttackTokenSubsystem->HasAttackToken(Enemy, EWarriorAttackTokenType::Ranged)))
+		{
+			continue;
+		}
+
+		const UAbilitySystemComponent* EnemyASC = Enemy->GetAbilitySystemComponent();
+
+		if (EnemyASC && EnemyASC->HasMatchingGameplayTag(WarriorGameplayTags::Enemy_Status_UnderAttack))
+		{
+			continue;
+		}
+
+		DemotionCandidates.Add(Enemy);
+
+		if (DemotionCandidates.Num() >= CrowdSettings.MaxDemotionsPerEvaluation)
+		{
+			break;
+		}
+	}
+
+	for (AWarriorEnemyCharacter* Enemy : DemotionCandidates)
+	{
+		const FVector GroundLocation = Enemy->GetActorLocation() - FVector(0.f, 0.f, Enemy->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+
+		// 先加入群体并取消波次标记再回收，回收时广播的注销不会让波次误以为敌人已经离场而补刷
+		const int32 EntityIndex = AddEntity(TSoftClassPtr<AWarriorEnemyCharacter>(Enemy->GetClass()), Enemy->GetClass(), GroundLocation,
+			Enemy->GetEnemyUIComponent()->GetCachedHealthPercent());
+
+		EntityVelocities[EntityIndex] = Enemy->GetVelocity() * FVector(1.f, 1.f, 0.f);
+		EntityTargetLocations[EntityIndex] = InHeroLocation;
+
+		EnemyRegistrySubsystem->UnmarkWaveEnemy(Enemy);
+
+		CrowdStats.Demotions++;
+		INC_DWORD_STAT(STAT_WarriorCrowdDemotions);
+
+		if (!EnemyPoolSubsystem || !EnemyPoolSubsystem->ReleaseEnemy(Enemy))
+		{
+			Enemy->Destroy();
+		}
+	}
+}
@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorEnemyDormancySubsystem.h"
+
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Kismet/GameplayStatics.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Evaluate Enemy Dormancy"), STAT_WarriorEvaluateEnemyDormancy, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Enemies"), STAT_WarriorDormantEnemies, STATGROUP_WarriorSurvival);
+
+void UWarriorEnemyDormancySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		DormancySettings = BaseGameMode->GetEnemyDormancySettings();
+	}
+
+	DormancySettings.WakeDistance = FMath::Min(DormancySettings.WakeDistance, DormancySettings.DormancyDistance);
+}
+
+void UWarriorEnemyDormancySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastEvaluation += DeltaTime;
+
+	if (TimeSinceLastEvaluation >= DormancySettings.EvaluationInterval)
+	{
+		TimeSinceLastEvaluation = 0.f;
+
+		EvaluateDormancy();
+	}
+}
+
+TStatId UWarriorEnemyDormancySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorEnemyDormancySubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorEnemyDormancySubsystem::EvaluateDormancy()
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorEvaluateEnemyDormancy);
+
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (!EnemyRegistrySubsystem || !PlayerPawn)
+	{
+		return;
+	}
+
+	if (!DormancySettings.bEnableDormancy)
+	{
+		if (NumDormantEnemies > 0)
+		{
+			WakeAllEnemies();
+		}
+
+		return;
+	}
+
+	const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+	const float DormancyDistanceSquared = FMath::Square(DormancySettings.DormancyDistance);
+	const float WakeDistanceSquared = FMath::Square(DormancySettings.WakeDistance);
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	const TArray<AWarriorEnemyCharacter*>& RegisteredEnemies = EnemyRegistrySubsystem->GetRegisteredEnemies();
+	const TArray<FVector>& EnemyLocations = EnemyRegistrySubsystem->GetEnemyLocations();
+
+	NumDormantEnemies = 0;
+
+	for (int32 RegistryIndex = 0; RegistryIndex < RegisteredEnemies.Num(); RegistryIndex++)
+	{
+		AWarriorEnemyCharacter* Enemy = RegisteredEnemies[RegistryIndex];
+
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		const float DistanceSquared = FVector::DistSquared(EnemyLocations[RegistryIndex], PlayerLocation);
+
+		if (Enemy->IsDormant())
+		{
+			if (DistanceSquared <= WakeDistanceSquared)
+			{
+				Enemy->WakeFromDormancy();
+				continue;
+			}
+		}
+		else if (DistanceSquared > DormancyDistanceSquared
+			&& !EnemyRegistrySubsystem->IsEnemyDeadAt(RegistryIndex)
+			&& CurrentTime - Enemy->GetLastWakeTime() >= DormancySettings.MinAwakeTime)
+		{
+			Enemy->EnterDormancy();
+		}
+
+		if (Enemy->IsDormant())
+		{
+			NumDormantEnemies++;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WarriorDormantEnemies, NumDormantEnemies);
+}
+
+void UWarriorEnemyDormancySubsystem::WakeAllEnemies()
+{
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+
+	if (!EnemyRegistrySubsystem)
+	{
+		return;
+	}
+
+	for (AWarriorEnemyCharacter* Enemy : EnemyRegistrySubsystem->GetRegisteredEnemies())
+	{
+		if (IsValid(Enemy))
+		{
+			Enemy->WakeFromDormancy();
+		}
+	}
+
+	NumDormantEnemies = 0;
+
+	SET_DWORD_STAT(STAT_WarriorDormantEnemies, 0);
+}
@@ -0,0 +1,377 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorEnemyPoolSubsystem.h"
+
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Engine/AssetManager.h"
+#include "Subsystems/WarriorSpawnPointSubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemy Pool Hits"), STAT_WarriorEnemyPoolHits, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemy Pool Misses"), STAT_WarriorEnemyPoolMisses, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Pooled Enemies"), STAT_WarriorEnemyPoolDormant, STATGROUP_WarriorSurvival);
+DECLARE_CYCLE_STAT(TEXT("Process Enemy Summon Queue"), STAT_WarriorProcessEnemySummonQueue, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemy Summon Queue Depth"), STAT_WarriorEnemySummonQueueDepth, STATGROUP_WarriorSurvival);
+
+void UWarriorEnemyPoolSubsystem::Deinitialize()
+{
+	for (const TPair<TSoftClassPtr<AWarriorEnemyCharacter>, TSharedPtr<FStreamableHandle>>& LoadHandlePair : EnemyClassLoadHandles)
+	{
+		if (LoadHandlePair.Value.IsValid())
+		{
+			LoadHandlePair.Value->ReleaseHandle();
+		}
+	}
+
+	EnemyClassLoadHandles.Empty();
+	PendingClassLoadCallbacks.Empty();
+	PendingSummonRequests.Empty();
+	PendingPrewarmRequests.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWarriorEnemyPoolSubsystem::RequestEnemyClassLoad(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, FStreamableDelegate InOnLoaded)
+{
+	if (InSoftEnemyClass.IsNull())
+	{
+		InOnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	const TSharedPtr<FStreamableHandle>* ExistingLoadHandle = EnemyClassLoadHandles.Find(InSoftEnemyClass);
+
+	if (ExistingLoadHandle && ExistingLoadHandle->IsValid() && (*ExistingLoadHandle)->HasLoadCompleted())
+	{
+		InOnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	// 加载中的类别只记录回调，所有请求方共享同一次加载
+	PendingClassLoadCallbacks.FindOrAdd(InSoftEnemyClass).Add(MoveTemp(InOnLoaded));
+
+	if (ExistingLoadHandle)
+	{
+		return;
+	}
+
+	// 先占位，完成回调同步触发时不会重复发起加载
+	EnemyClassLoadHandles.Add(InSoftEnemyClass, nullptr);
+
+	TSharedPtr<FStreamableHandle> NewLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(InSoftEnemyClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnEnemyClassLoadCompleted, InSoftEnemyClass),
+		FStreamableManager::AsyncLoadHighPriority, true);
+
+	if (NewLoadHandle.IsValid())
+	{
+		// 句柄常驻到世界结束，之后的召唤不会再次触发加载
+		EnemyClassLoadHandles.Add(InSoftEnemyClass, NewLoadHandle);
+	}
+	else
+	{
+		// 加载失败时移除占位以便之后重试，等待者会拿到空的类别
+		EnemyClassLoadHandles.Remove(InSoftEnemyClass);
+
+		OnEnemyClassLoadCompleted(InSoftEnemyClass);
+	}
+}
+
+void UWarriorEnemyPoolSubsystem::OnEnemyClassLoadCompleted(TSoftClassPtr<AWarriorEnemyCharacter> InSoftEnemyClass)
+{
+	TArray<FStreamableDelegate> LoadCallbacks;
+
+	if (!PendingClassLoadCallbacks.RemoveAndCopyValue(InSoftEnemyClass, LoadCallbacks))
+	{
+		return;
+	}
+
+	for (const FStreamableDelegate& LoadCallback : LoadCallbacks)
+	{
+		LoadCallback.ExecuteIfBound();
+	}
+}
+
+void UWarriorEnemyPoolSubsystem::EnqueueSummon(FWarriorEnemySummonRequest&& InSummonRequest)
+{
+	PendingSummonRequests.Add(MoveTemp(InSummonRequest));
+
+	SET_DWORD_STAT(STAT_WarriorEnemySummonQueueDepth, PendingSummonRequests.Num());
+
+	ScheduleSummonQueueProcessing();
+}
+
+void UWarriorEnemyPoolSubsystem::QueuePrewarmEnemies(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass,
+	UClass* InLoadedEnemyClass, int32 InDesiredDormantCount)
+{
+	if (InSoftEnemyClass.IsNull() || !InLoadedEnemyClass || InDesiredDormantCount <= 0)
+	{
+		return;
+	}
+
+	// 该类别已有预热请求时只提高目标数量
+	for (FWarriorEnemyPrewarmRequest& PrewarmRequest : PendingPrewarmRequests)
+	{
+		if (PrewarmRequest.SoftEnemyClass == InSoftEnemyClass)
+		{
+			PrewarmRequest.DesiredDormantCount = FMath::Max(PrewarmRequest.DesiredDormantCount, InDesiredDormantCount);
+			return;
+		}
+	}
+
+	FWarriorEnemyPrewarmRequest& PrewarmRequest = PendingPrewarmRequests.AddDefaulted_GetRef();
+	PrewarmRequest.SoftEnemyClass = InSoftEnemyClass;
+	PrewarmRequest.LoadedEnemyClass = InLoadedEnemyClass;
+	PrewarmRequest.DesiredDormantCount = InDesiredDormantCount;
+
+	ScheduleSummonQueueProcessing();
+}
+
+void UWarriorEnemyPoolSubsystem::PrewarmEnemies(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass,
+	UClass* InLoadedEnemyClass, int32 InDesiredDormantCount)
+{
+	if (InSoftEnemyClass.IsNull() || !InLoadedEnemyClass)
+	{
+		return;
+	}
+
+	FWarriorEnemyPoolBucket& Bucket = EnemyPoolBuckets.FindOrAdd(InSoftEnemyClass);
+
+	const int32 TargetDormantCount = FMath::Min(InDesiredDormantCount, MaxDormantEnemiesPerClass);
+
+	while (Bucket.DormantEnemies.Num() < TargetDormantCount)
+	{
+		AWarriorEnemyCharacter* DormantEnemy = SpawnDormantEnemy(InLoadedEnemyClass);
+
+		if (!DormantEnemy)
+		{
+			break;
+		}
+
+		Bucket.DormantEnemies.Add(DormantEnemy);
+
+		EnemyPoolStats.PrewarmedEnemies++;
+		INC_DWORD_STAT(STAT_WarriorEnemyPoolDormant);
+	}
+}
+
+AWarriorEnemyCharacter* UWarriorEnemyPoolSubsystem::AcquireEnemy(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass,
+	UClass* InLoadedEnemyClass, const FVector& InLocation, const FRotator& InRotation)
+{
+	FWarriorEnemyPoolBucket& Bucket = EnemyPoolBuckets.FindOrAdd(InSoftEnemyClass);
+
+	while (!Bucket.DormantEnemies.IsEmpty())
+	{
+		AWarriorEnemyCharacter* PooledEnemy = Bucket.DormantEnemies.Pop(EAllowShrinking::No);
+		DEC_DWORD_STAT(STAT_WarriorEnemyPoolDormant);
+
+		if (IsValid(PooledEnemy))
+		{
+			EnemyPoolStats.PoolHits++;
+			INC_DWORD_STAT(STAT_WarriorEnemyPoolHits);
+
+			PooledEnemy->OnAcquiredFromPool(InLocation, InRotation);
+
+			return PooledEnemy;
+		}
+	}
+
+	EnemyPoolStats.PoolMisses++;
+	INC_DWORD_STAT(STAT_WarriorEnemyPoolMisses);
+
+	if (!InLoadedEnemyClass)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParam;
+	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	return GetWorld()->SpawnActor<AWarriorEnemyCharacter>(InLoadedEnemyClass, InLocation, InRotation, SpawnParam);
+}
+
+bool UWarriorEnemyPoolSubsystem::ReleaseEnemy(AWarriorEnemyCharacter* InEnemyToRelease)
+{
+	if (!IsValid(InEnemyToRelease))
+	{
+		return false;
+	}
+
+	// 只回收已经由对象池管理的类别，关卡中手动放置的敌人仍按原流程销毁
+	FWarriorEnemyPoolBucket* Bucket = EnemyPoolBuckets.Find(TSoftClassPtr<AWarriorEnemyCharacter>(InEnemyToRelease->GetClass()));
+
+	if (!Bucket || Bucket->DormantEnemies.Num() >= MaxDormantEnemiesPerClass)
+	{
+		return false;
+	}
+
+	InEnemyToRelease->OnReleasedToPool();
+
+	Bucket->DormantEnemies.Add(InEnemyToRelease);
+
+	EnemyPoolStats.ReleasedToPool++;
+	INC_DWORD_STAT(STAT_WarriorEnemyPoolDormant);
+
+	return true;
+}
+
+void UWarriorEnemyPoolSubsystem::FlushDormantEnemies(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass)
+{
+	FWarriorEnemyPoolBucket Bucket;
+
+	if (!EnemyPoolBuckets.RemoveAndCopyValue(InSoftEnemyClass, Bucket))
+	{
+		return;
+	}
+
+	for (AWarriorEnemyCharacter* DormantEnemy : Bucket.DormantEnemies)
+	{
+		DEC_DWORD_STAT(STAT_WarriorEnemyPoolDormant);
+
+		if (IsValid(DormantEnemy))
+		{
+			DormantEnemy->Destroy();
+		}
+	}
+}
+
+int32 UWarriorEnemyPoolSubsystem::GetNumDormantEnemies(TSoftClassPtr<AWarriorEnemyCharacter> InSoftEnemyClass) const
+{
+	const FWarriorEnemyPoolBucket* Bucket = EnemyPoolBuckets.Find(InSoftEnemyClass);
+
+	return Bucket ? Bucket->DormantEnemies.Num() : 0;
+}
+
+void UWarriorEnemyPoolSubsystem::ResetEnemyPoolStats()
+{
+	EnemyPoolStats = FWarriorEnemyPoolStats();
+}
+
+AWarriorEnemyCharacter* UWarriorEnemyPoolSubsystem::SpawnDormantEnemy(UClass* InLoadedEnemyClass) const
+{
+	const FTransform SpawnTransform = FTransform::Identity;
+
+	AWarriorEnemyCharacter* DormantEnemy = GetWorld()->SpawnActorDeferred<AWarriorEnemyCharacter>(InLoadedEnemyClass, SpawnTransform,
+		nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+	if (!DormantEnemy)
+	{
+		return nullptr;
+	}
+
+	// 休眠实例不自动生成AI控制器，取出时再占有
+	DormantEnemy->AutoPossessAI = EAutoPossessAI::Disabled;
+	DormantEnemy->FinishSpawning(SpawnTransform);
+	DormantEnemy->OnReleasedToPool();
+
+	return DormantEnemy;
+}
+
+void UWarriorEnemyPoolSubsystem::ScheduleSummonQueueProcessing()
+{
+	if (bSummonQueueProcessingScheduled || (PendingSummonRequests.IsEmpty() && PendingPrewarmRequests.IsEmpty()))
+	{
+		return;
+	}
+
+	bSummonQueueProcessingScheduled = true;
+
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ThisClass::ProcessSummonQueue);
+}
+
+void UWarriorEnemyPoolSubsystem::ProcessSummonQueue()
+{
+	bSummonQueueProcessingScheduled = false;
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorProcessEnemySummonQueue);
+
+	const double StartTimeSeconds = FPlatformTime::Seconds();
+	const double FrameBudgetSeconds = SummonFrameBudgetMs / 1000.0;
+
+	int32 NumProcessed = 0;
+
+	while (!PendingSummonRequests.IsEmpty() || !PendingPrewarmRequests.IsEmpty())
+	{
+		if (NumProcessed >= MaxSummonSpawnsPerFrame)
+		{
+			break;
+		}
+
+		if (NumProcessed > 0 && FPlatformTime::Seconds() - StartTimeSeconds >= FrameBudgetSeconds)
+		{
+			break;
+		}
+
+		// 召唤优先于预热，先出队再处理，回调中新增的请求会排在队尾
+		if (!PendingSummonRequests.IsEmpty())
+		{
+			FWarriorEnemySummonRequest SummonRequest = MoveTemp(PendingSummonRequests[0]);
+			PendingSummonRequests.RemoveAt(0, 1, EAllowShrinking::No);
+
+			// 请求方已经销毁，不再生成无人认领的敌人
+			if (!SummonRequest.OnEnemySummoned.IsBound())
+			{
+				continue;
+			}
+
+			ProcessSummonRequest(SummonRequest);
+		}
+		else if (!ProcessPrewarmRequest(PendingPrewarmRequests[0]))
+		{
+			PendingPrewarmRequests.RemoveAt(0, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		NumProcessed++;
+	}
+
+	SET_DWORD_STAT(STAT_WarriorEnemySummonQueueDepth, PendingSummonRequests.Num());
+
+	ScheduleSummonQueueProcessing();
+}
+
+void UWarriorEnemyPoolSubsystem::ProcessSummonRequest(FWarriorEnemySummonRequest& InSummonRequest)
+{
+	FVector SpawnGroundLocation = InSummonRequest.SpawnOrigin;
+
+	if (const UWarriorSpawnPointSubsystem* SpawnPointSubsystem = GetWorld()->GetSubsystem<UWarriorSpawnPointSubsystem>())
+	{
+		SpawnPointSubsystem->FindSpawnPointNear(InSummonRequest.SpawnOrigin, InSummonRequest.RandomSpawnRadius, SpawnGroundLocation);
+	}
+
+	const FVector SpawnLocation = UWarriorSpawnPointSubsystem::GetSpawnLocationForEnemyClass(SpawnGroundLocation, InSummonRequest.LoadedEnemyClass);
+
+	AWarriorEnemyCharacter* SummonedEnemy = AcquireEnemy(InSummonRequest.SoftEnemyClass, InSummonRequest.LoadedEnemyClass,
+		SpawnLocation, InSummonRequest.SpawnRotation);
+
+	if (SummonedEnemy)
+	{
+		EnemyPoolStats.SummonedEnemies++;
+	}
+
+	InSummonRequest.OnEnemySummoned.Execute(SummonedEnemy);
+}
+
+bool UWarriorEnemyPoolSubsystem::ProcessPrewarmRequest(const FWarriorEnemyPrewarmRequest& InPrewarmRequest)
+{
+	FWarriorEnemyPoolBucket& Bucket = EnemyPoolBuckets.FindOrAdd(InPrewarmRequest.SoftEnemyClass);
+
+	if (Bucket.DormantEnemies.Num() >= FMath::Min(InPrewarmRequest.DesiredDormantCount, MaxDormantEnemiesPerClass))
+	{
+		return false;
+	}
+
+	AWarriorEnemyCharacter* DormantEnemy = SpawnDormantEnemy(InPrewarmRequest.LoadedEnemyClass);
+
+	if (!DormantEnemy)
+	{
+		return false;
+	}
+
+	Bucket.DormantEnemies.Add(DormantEnemy);
+
+	EnemyPoolStats.PrewarmedEnemies++;
+	INC_DWORD_STAT(STAT_WarriorEnemyPoolDormant);
+
+	return true;
+}
@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "GenericTeamAgentInterface.h"
+#include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+#include "Characters/WarriorEnemyCharacter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Refresh Enemy Registry"), STAT_WarriorRefreshEnemyRegistry, STATGROUP_WarriorSurvival);
+DECLARE_CYCLE_STAT(TEXT("Query Enemy Registry"), STAT_WarriorQueryEnemyRegistry, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Enemies"), STAT_WarriorRegisteredEnemies, STATGROUP_WarriorSurvival);
+
+void UWarriorEnemyRegistrySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorRefreshEnemyRegistry);
+
+	for (int32 RegistryIndex = 0; RegistryIndex < RegisteredEnemies.Num(); RegistryIndex++)
+	{
+		RefreshEnemyDataAt(RegistryIndex);
+	}
+}
+
+TStatId UWarriorEnemyRegistrySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorEnemyRegistrySubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorEnemyRegistrySubsystem::RegisterEnemy(AWarriorEnemyCharacter* InEnemy)
+{
+	if (!IsValid(InEnemy) || InEnemy->EnemyRegistryIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	InEnemy->EnemyRegistryIndex = RegisteredEnemies.Add(InEnemy);
+
+	EnemyLocations.AddZeroed();
+	EnemyTeamIds.Add(FGenericTeamId::NoTeam.GetId());
+	EnemyDeadFlags.AddZeroed();
+	EnemyWaveFlags.AddZeroed();
+	EnemyClassIds.Add(GetOrAddEnemyClassId(InEnemy->GetClass()));
+
+	RefreshEnemyDataAt(InEnemy->EnemyRegistryIndex);
+
+	SET_DWORD_STAT(STAT_WarriorRegisteredEnemies, RegisteredEnemies.Num());
+
+	OnEnemyRegistered.Broadcast(InEnemy);
+}
+
+void UWarriorEnemyRegistrySubsystem::UnregisterEnemy(AWarriorEnemyCharacter* InEnemy)
+{
+	if (!InEnemy || !RegisteredEnemies.IsValidIndex(InEnemy->EnemyRegistryIndex) || RegisteredEnemies[InEnemy->EnemyRegistryIndex] != InEnemy)
+	{
+		return;
+	}
+
+	const int32 RemovedIndex = InEnemy->EnemyRegistryIndex;
+	const bool bWasWaveEnemy = EnemyWaveFlags[RemovedIndex] != 0;
+
+	// 与末尾元素交换后删除，只需要修正被移动的那个敌人记录的下标
+	RegisteredEnemies.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+	EnemyLocations.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+	EnemyTeamIds.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+	EnemyDeadFlags.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+	EnemyWaveFlags.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+	EnemyClassIds.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+
+	if (RegisteredEnemies.IsValidIndex(RemovedIndex))
+	{
+		RegisteredEnemies[RemovedIndex]->EnemyRegistryIndex = RemovedIndex;
+	}
+
+	InEnemy->EnemyRegistryIndex = INDEX_NONE;
+
+	if (bWasWaveEnemy)
+	{
+		NumWaveEnemies--;
+	}
+
+	SET_DWORD_STAT(STAT_WarriorRegisteredEnemies, RegisteredEnemies.Num());
+
+	OnEnemyUnregistered.Broadcast(InEnemy, bWasWaveEnemy);
+}
+
+void UWarriorEnemyRegistrySubsystem::MarkEnemyAsWaveEnemy(AWarriorEnemyCharacter* InEnemy)
+{
+	RegisterEnemy(InEnemy);
+
+	if (!InEnemy || InEnemy->EnemyRegistryIndex == INDEX_NONE || EnemyWaveFlags[InEnemy->EnemyRegistryIndex] != 0)
+	{
+		return;
+	}
+
+	EnemyWaveFlags[InEnemy->EnemyRegistryIndex] = 1;
+
+	NumWaveEnemies++;
+}
+
+void UWarriorEnemyRegistrySubsystem::UnmarkWaveEnemy(AWarriorEnemyCharacter* InEnemy)
+{
+	if (!InEnemy || InEnemy->EnemyRegistryIndex == INDEX_NONE || EnemyWaveFlags[InEnemy->EnemyRegistryIndex] == 0)
+	{
+		return;
+	}
+
+	EnemyWaveFlags[InEnemy->EnemyRegistryIndex] = 0;
+
+	NumWaveEnemies--;
+}
+
+void UWarriorEnemyRegistrySubsystem::QueryEnemiesInRadius(const FVector& InOrigin, float InRadius,
+	TArray<AWarriorEnemyCharacter*>& OutEnemies, bool bIncludeDead) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorQueryEnemyRegistry);
+
+	const float RadiusSquared = FMath::Square(InRadius);
+
+	for (int32 RegistryIndex = 0; RegistryIndex < EnemyLocations.Num(); RegistryIndex++)
+	{
+		if (!bIncludeDead && EnemyDeadFlags[RegistryIndex])
+		{
+			continue;
+		}
+
+		if (FVector::DistSquared(EnemyLocations[RegistryIndex], InOrigin) <= RadiusSquared)
+		{
+			OutEnemies.Add(RegisteredEnemies[RegistryIndex]);
+		}
+	}
+}
+
+void UWarriorEnemyRegistrySubsystem::QueryEnemiesInCone(const FVector& InOrigin, const FVector& InDirection, float InRadius,
+	float InHalfAngleDegrees, TArray<AWarriorEnemyCharacter*>& OutEnemies, bool bIncludeDead) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorQueryEnemyRegistry);
+
+	const float RadiusSquared = FMath::Square(InRadius);
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(InHalfAngleDegrees));
+	const FVector ConeDirection = InDirection.GetSafeNormal();
+
+	for (int32 RegistryIndex = 0; RegistryIndex < EnemyLocations.Num(); RegistryIndex++)
+	{
+		if (!bIncludeDead && EnemyDeadFlags[RegistryIndex])
+		{
+			continue;
+		}
+
+		const FVector ToEnemy = EnemyLocations[RegistryIndex] - InOrigin;
+		const float DistanceSquared = ToEnemy.SizeSquared();
+
+		if (DistanceSquared > RadiusSquared)
+		{
+			continue;
+		}
+
+		// 比较 cos 值避免开方与反三角函数，与原点重合的敌人视为在锥内
+		if (DistanceSquared <= KINDA_SMALL_NUMBER || FVector::DotProduct(ToEnemy, ConeDirection) >= CosHalfAngle * FMath::Sqrt(DistanceSquared))
+		{
+			OutEnemies.Add(RegisteredEnemies[RegistryIndex]);
+		}
+	}
+}
+
+void UWarriorEnemyRegistrySubsystem::QueryEnemiesInBox(const FVector& InCenter, const FQuat& InRotation, const FVector& InHalfExtent,
+	TArray<AWarriorEnemyCharacter*>& OutEnemies, bool bIncludeDead) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorQueryEnemyRegistry);
+
+	for (int32 RegistryIndex = 0; RegistryIndex < EnemyLocations.Num(); RegistryIndex++)
+	{
+		if (!bIncludeDead && EnemyDeadFlags[RegistryIndex])
+		{
+			continue;
+		}
+
+		const FVector LocalLocation = InRotation.UnrotateVector(EnemyLocations[RegistryIndex] - InCenter);
+
+		if (FMath::Abs(LocalLocation.X) <= InHalfExtent.X && FMath::Abs(LocalLocation.Y) <= InHalfExtent.Y && FMath::Abs(LocalLocation.Z) <= InHalfExtent.Z)
+		{
+			OutEnemies.Add(RegisteredEnemies[RegistryIndex]);
+		}
+	}
+}
+
+AWarriorEnemyCharacter* UWarriorEnemyRegistrySubsystem::FindNearestEnemy(const FVector& InOrigin, float InMaxRadius, bool bIncludeDead) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorQueryEnemyRegistry);
+
+	float ClosestDistanceSquared = FMath::Square(InMaxRadius);
+	AWarriorEnemyCharacter* ClosestEnemy = nullptr;
+
+	for (int32 RegistryIndex = 0; RegistryIndex < EnemyLocations.Num(); RegistryIndex++)
+	{
+		if (!bIncludeDead && EnemyDeadFlags[RegistryIndex])
+		{
+			continue;
+		}
+
+		const float DistanceSquared = FVector::DistSquared(EnemyLocations[RegistryIndex], InOrigin);
+
+		if (DistanceSquared <= ClosestDistanceSquared)
+		{
+			ClosestDistanceSquared = DistanceSquared;
+			ClosestEnemy = RegisteredEnemies[RegistryIndex];
+		}
+	}
+
+	return ClosestEnemy;
+}
+
+void UWarriorEnemyRegistrySubsystem::RefreshEnemyDataAt(int32 InRegistryIndex)
+{
+	const AWarriorEnemyCharacter* Enemy = RegisteredEnemies[InRegistryIndex];
+
+	if (!IsValid(Enemy))
+	{
+		EnemyDeadFlags[InRegistryIndex] = 1;
+		return;
+	}
+
+	EnemyLocations[InRegistryIndex] = Enemy->GetActorLocation();
+
+	if (const UAbilitySystemComponent* EnemyASC = Enemy->GetAbilitySystemComponent())
+	{
+		EnemyDeadFlags[InRegistryIndex] = EnemyASC->HasMatchingGameplayTag(WarriorGameplayTags::Shared_Status_Dead) ? 1 : 0;
+	}
+
+	if (const IGenericTeamAgentInterface* TeamAgent = Cast<IGenericTeamAgentInterface>(Enemy->GetController()))
+	{
+		EnemyTeamIds[InRegistryIndex] = TeamAgent->GetGenericTeamId().GetId();
+	}
+}
+
+int32 UWarriorEnemyRegistrySubsystem::GetOrAddEnemyClassId(const UClass* InEnemyClass)
+{
+	if (const int32* FoundClassId = EnemyClassIdMap.Find(InEnemyClass))
+	{
+		return *FoundClassId;
+	}
+
+	return EnemyClassIdMap.Add(InEnemyClass, EnemyClassIdMap.Num());
+}
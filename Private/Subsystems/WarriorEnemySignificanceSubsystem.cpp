@@ -0,0 +1,242 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorEnemySignificanceSubsystem.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/WarriorBudgetedSkeletalMeshComponent.h"
+#include "IAnimationBudgetAllocator.h"
+#include "Kismet/GameplayStatics.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Evaluate Enemy Significance"), STAT_WarriorEvaluateEnemySignificance, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("High Significance Enemies"), STAT_WarriorHighSignificanceEnemies, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Medium Significance Enemies"), STAT_WarriorMediumSignificanceEnemies, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Low Significance Enemies"), STAT_WarriorLowSignificanceEnemies, STATGROUP_WarriorSurvival);
+
+void UWarriorEnemySignificanceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		SignificanceSettings = BaseGameMode->GetEnemySignificanceSettings();
+		AnimationBudgetSettings = BaseGameMode->GetAnimationBudgetSettings();
+	}
+
+	RefreshAnimationBudget();
+}
+
+void UWarriorEnemySignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastEvaluation += DeltaTime;
+
+	if (TimeSinceLastEvaluation >= SignificanceSettings.EvaluationInterval)
+	{
+		TimeSinceLastEvaluation = 0.f;
+
+		EvaluateSignificance();
+	}
+}
+
+TStatId UWarriorEnemySignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorEnemySignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorEnemySignificanceSubsystem::EvaluateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorEvaluateEnemySignificance);
+
+	RefreshAnimationBudget();
+
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	const APlayerCameraManager* PlayerCameraManager = UGameplayStatics::GetPlayerCameraManager(this, 0);
+
+	if (!EnemyRegistrySubsystem || !PlayerPawn || !PlayerCameraManager)
+	{
+		return;
+	}
+
+	const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+	const FVector CameraLocation = PlayerCameraManager->GetCameraLocation();
+	const FVector CameraForward = PlayerCameraManager->GetCameraRotation().Vector();
+	const float ScreenSizeScale = 1.f / FMath::Tan(FMath::DegreesToRadians(PlayerCameraManager->GetFOVAngle() * 0.5f));
+	const float CombatRelevanceRadiusSquared = FMath::Square(SignificanceSettings.CombatRelevanceRadius);
+	IAnimationBudgetAllocator* AnimationBudgetAllocator = bAnimationBudgetEnabled ? IAnimationBudgetAllocator::Get(GetWorld()) : nullptr;
+
+	const TArray<AWarriorEnemyCharacter*>& RegisteredEnemies = EnemyRegistrySubsystem->GetRegisteredEnemies();
+	const TArray<FVector>& EnemyLocations = EnemyRegistrySubsystem->GetEnemyLocations();
+
+	SignificanceCandidates.Reset(RegisteredEnemies.Num());
+
+	for (int32 RegistryIndex = 0; RegistryIndex < RegisteredEnemies.Num(); RegistryIndex++)
+	{
+		AWarriorEnemyCharacter* Enemy = RegisteredEnemies[RegistryIndex];
+
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		const FVector& EnemyLocation = EnemyLocations[RegistryIndex];
+
+		FSignificanceCandidate& Candidate = SignificanceCandidates.AddDefaulted_GetRef();
+		Candidate.Enemy = Enemy;
+		Candidate.DistanceSquared = FVector::DistSquared(EnemyLocation, PlayerLocation);
+		Candidate.bCombatRelevant = Candidate.DistanceSquared <= CombatRelevanceRadiusSquared;
+
+		if (AnimationBudgetAllocator)
+		{
+			UWarriorBudgetedSkeletalMeshComponent* BudgetedMesh = Cast<UWarriorBudgetedSkeletalMeshComponent>(Enemy->GetMesh());
+
+			if (BudgetedMesh && BudgetedMesh->IsManagedByAnimationBudget())
+			{
+				const float AnimationSignificance = 1.f - FMath::Clamp(FMath::Sqrt(Candidate.DistanceSquared) / AnimationBudgetSettings.MaxSignificanceDistance, 0.f, 1.f);
+
+				// 交战中的敌人依赖动画通知判定攻击，不允许跳帧
+				AnimationBudgetAllocator->SetComponentSignificance(BudgetedMesh, AnimationSignificance, Candidate.bCombatRelevant);
+			}
+		}
+
+		if (Candidate.bCombatRelevant)
+		{
+			Candidate.DesiredTier = EWarriorEnemySignificanceTier::High;
+			continue;
+		}
+
+		// 屏幕占比近似为包围球半径与该距离处半屏宽度之比，相机背后的敌人视为不在屏幕内
+		const FVector ToEnemy = EnemyLocation - CameraLocation;
+		const float CameraDistance = ToEnemy.Size();
+		const float ScreenSize = FVector::DotProduct(ToEnemy, CameraForward) > 0.f
+			? Enemy->GetCapsuleComponent()->Bounds.SphereRadius * ScreenSizeScale / FMath::Max(CameraDistance, 1.f)
+			: 0.f;
+
+		Candidate.DesiredTier = EWarriorEnemySignificanceTier::Low;
+
+		for (const EWarriorEnemySignificanceTier Tier : {EWarriorEnemySignificanceTier::High, EWarriorEnemySignificanceTier::Medium})
+		{
+			const FWarriorSignificanceTierSettings& TierSettings = GetTierSettings(Tier);
+
+			if (Candidate.DistanceSquared <= FMath::Square(TierSettings.MaxDistance) && ScreenSize >= TierSettings.MinScreenSize)
+			{
+				Candidate.DesiredTier = Tier;
+				break;
+			}
+		}
+	}
+
+	// 交战中的敌人优先占用名额，其余按距离由近到远
+	SignificanceCandidates.Sort([](const FSignificanceCandidate& A, const FSignificanceCandidate& B)
+	{
+		if (A.bCombatRelevant != B.bCombatRelevant)
+		{
+			return A.bCombatRelevant;
+		}
+
+		return A.DistanceSquared < B.DistanceSquared;
+	});
+
+	FMemory::Memzero(NumEnemiesPerTier);
+
+	for (const FSignificanceCandidate& Candidate : SignificanceCandidates)
+	{
+		int32 TierIndex = static_cast<int32>(Candidate.DesiredTier);
+
+		// 名额已满时降到下一级，Low 级别不限制数量
+		while (TierIndex < static_cast<int32>(EWarriorEnemySignificanceTier::Low))
+		{
+			const int32 MaxEnemiesInTier = GetTierSettings(static_cast<EWarriorEnemySignificanceTier>(TierIndex)).MaxEnemies;
+
+			if (MaxEnemiesInTier <= 0 || NumEnemiesPerTier[TierIndex] < MaxEnemiesInTier)
+			{
+				break;
+			}
+
+			TierIndex++;
+		}
+
+		NumEnemiesPerTier[TierIndex]++;
+
+		const EWarriorEnemySignificanceTier AssignedTier = static_cast<EWarriorEnemySignificanceTier>(TierIndex);
+
+		Candidate.Enemy->ApplySignificanceTier(AssignedTier, GetTierSettings(AssignedTier));
+	}
+
+	SET_DWORD_STAT(STAT_WarriorHighSignificanceEnemies, NumEnemiesPerTier[static_cast<int32>(EWarriorEnemySignificanceTier::High)]);
+	SET_DWORD_STAT(STAT_WarriorMediumSignificanceEnemies, NumEnemiesPerTier[static_cast<int32>(EWarriorEnemySignificanceTier::Medium)]);
+	SET_DWORD_STAT(STAT_WarriorLowSignificanceEnemies, NumEnemiesPerTier[static_cast<int32>(EWarriorEnemySignificanceTier::Low)]);
+}
+
+void UWarriorEnemySignificanceSubsystem::RefreshAnimationBudget()
+{
+	const bool bShouldEnableAnimationBudget = AnimationBudgetSettings.bEnableAnimationBudget && UWarriorBudgetedSkeletalMeshComponent::IsAnimationBudgetAllowed();
+
+	if (bShouldEnableAnimationBudget == bAnimationBudgetEnabled)
+	{
+		return;
+	}
+
+	IAnimationBudgetAllocator* AnimationBudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+
+	if (!AnimationBudgetAllocator || !EnemyRegistrySubsystem)
+	{
+		return;
+	}
+
+	bAnimationBudgetEnabled = bShouldEnableAnimationBudget;
+
+	if (bAnimationBudgetEnabled)
+	{
+		FAnimationBudgetAllocatorParameters BudgetParameters = AnimationBudgetAllocator->GetParameters();
+		BudgetParameters.BudgetInMs = AnimationBudgetSettings.BudgetMs;
+		BudgetParameters.MinQuality = AnimationBudgetSettings.MinQuality;
+		BudgetParameters.MaxTickRate = AnimationBudgetSettings.MaxTickRate;
+		BudgetParameters.MaxInterpolatedComponents = AnimationBudgetSettings.bInterpolateSkippedFrames ? AnimationBudgetSettings.MaxInterpolatedComponents : 0;
+
+		AnimationBudgetAllocator->SetParameters(BudgetParameters);
+		AnimationBudgetAllocator->SetEnabled(true);
+	}
+	else
+	{
+		AnimationBudgetAllocator->SetEnabled(false);
+	}
+
+	// 已经存在的敌人在分配器启用前完成了注册流程，这里补上注册；关闭时由各自的级别重新接管网格体的更新频率
+	for (AWarriorEnemyCharacter* Enemy : EnemyRegistrySubsystem->GetRegisteredEnemies())
+	{
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		if (UWarriorBudgetedSkeletalMeshComponent* BudgetedMesh = Cast<UWarriorBudgetedSkeletalMeshComponent>(Enemy->GetMesh()))
+		{
+			BudgetedMesh->SetRegisteredWithAnimationBudget(bAnimationBudgetEnabled);
+		}
+
+		Enemy->InvalidateSignificanceTier();
+	}
+}
+
+const FWarriorSignificanceTierSettings& UWarriorEnemySignificanceSubsystem::GetTierSettings(EWarriorEnemySignificanceTier InTier) const
+{
+	switch (InTier)
+	{
+	case EWarriorEnemySignificanceTier::High:
+		return SignificanceSettings.HighTier;
+
+	case EWarriorEnemySignificanceTier::Medium:
+		return SignificanceSettings.MediumTier;
+
+	default:
+		return SignificanceSettings.LowTier;
+	}
+}
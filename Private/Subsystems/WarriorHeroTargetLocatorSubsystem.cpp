@@ -0,0 +1,178 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorHeroTargetLocatorSubsystem.h"
+
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Controllers/WarriorAIController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Locate Hero Target"), STAT_WarriorLocateHeroTarget, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Hero Target Locator Traces"), STAT_WarriorHeroTargetLocatorTraces, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Hero Target Locator Clusters"), STAT_WarriorHeroTargetLocatorClusters, STATGROUP_WarriorSurvival);
+
+void UWarriorHeroTargetLocatorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		LocatorSettings = BaseGameMode->GetHeroTargetLocatorSettings();
+	}
+	else
+	{
+		// 没有战士游戏模式时敌人控制器保留各自的视觉感知
+		LocatorSettings.bEnableTargetLocator = false;
+	}
+}
+
+void UWarriorHeroTargetLocatorSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!LocatorSettings.bEnableTargetLocator)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorLocateHeroTarget);
+
+	SET_DWORD_STAT(STAT_WarriorHeroTargetLocatorTraces, 0);
+
+	APawn* HeroPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (!HeroPawn)
+	{
+		bLocatorPassInProgress = false;
+		return;
+	}
+
+	TimeSinceLastPass += DeltaTime;
+
+	if (!bLocatorPassInProgress)
+	{
+		if (TimeSinceLastPass < LocatorSettings.EvaluationInterval)
+		{
+			return;
+		}
+
+		TimeSinceLastPass = 0.f;
+
+		BeginLocatorPass(HeroPawn);
+	}
+
+	if (ProcessPendingTraces(HeroPawn))
+	{
+		ApplyLocatorResults(HeroPawn);
+
+		bLocatorPassInProgress = false;
+	}
+}
+
+TStatId UWarriorHeroTargetLocatorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorHeroTargetLocatorSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorHeroTargetLocatorSubsystem::BeginLocatorPass(const APawn* InHeroPawn)
+{
+	LocatorClusters.Reset();
+	LocatorCandidates.Reset();
+	ClusterIndexByCell.Reset();
+	NextClusterToTrace = 0;
+	bLocatorPassInProgress = true;
+
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>();
+
+	if (!EnemyRegistrySubsystem)
+	{
+		return;
+	}
+
+	const FVector HeroLocation = InHeroPawn->GetActorLocation();
+	const float SightRadiusSquared = FMath::Square(LocatorSettings.SightRadius);
+
+	const TArray<AWarriorEnemyCharacter*>& RegisteredEnemies = EnemyRegistrySubsystem->GetRegisteredEnemies();
+	const TArray<FVector>& EnemyLocations = EnemyRegistrySubsystem->GetEnemyLocations();
+
+	for (int32 RegistryIndex = 0; RegistryIndex < RegisteredEnemies.Num(); RegistryIndex++)
+	{
+		const AWarriorEnemyCharacter* Enemy = RegisteredEnemies[RegistryIndex];
+		const FVector& EnemyLocation = EnemyLocations[RegistryIndex];
+
+		if (!IsValid(Enemy) || EnemyRegistrySubsystem->IsEnemyDeadAt(RegistryIndex)
+			|| FVector::DistSquared(EnemyLocation, HeroLocation) > SightRadiusSquared)
+		{
+			continue;
+		}
+
+		// 已经锁定目标或正在休眠的敌人不需要检测
+		AWarriorAIController* WarriorAIController = Enemy->GetController<AWarriorAIController>();
+
+		if (!WarriorAIController || WarriorAIController->IsDormant() || WarriorAIController->HasTargetActor())
+		{
+			continue;
+		}
+
+		const FIntVector Cell(
+			FMath::FloorToInt(EnemyLocation.X / LocatorSettings.ClusterCellSize),
+			FMath::FloorToInt(EnemyLocation.Y / LocatorSettings.ClusterCellSize),
+			FMath::FloorToInt(EnemyLocation.Z / LocatorSettings.ClusterCellSize));
+
+		int32& ClusterIndex = ClusterIndexByCell.FindOrAdd(Cell, INDEX_NONE);
+
+		// 每格第一个敌人的眼睛位置作为该组的代表点
+		if (ClusterIndex == INDEX_NONE)
+		{
+			ClusterIndex = LocatorClusters.Num();
+
+			FLocatorCluster& Cluster = LocatorClusters.AddDefaulted_GetRef();
+			Cluster.TraceStart = EnemyLocation + FVector(0.f, 0.f, LocatorSettings.EyeHeightOffset);
+			Cluster.bHasLineOfSight = false;
+		}
+
+		FLocatorCandidate& Candidate = LocatorCandidates.AddDefaulted_GetRef();
+		Candidate.AIController = WarriorAIController;
+		Candidate.ClusterIndex = ClusterIndex;
+	}
+
+	SET_DWORD_STAT(STAT_WarriorHeroTargetLocatorClusters, LocatorClusters.Num());
+}
+
+bool UWarriorHeroTargetLocatorSubsystem::ProcessPendingTraces(const APawn* InHeroPawn)
+{
+	const FVector TraceEnd = InHeroPawn->GetActorLocation();
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(HeroTargetLocator), false, InHeroPawn);
+
+	int32 NumTraces = 0;
+
+	while (NextClusterToTrace < LocatorClusters.Num() && NumTraces < LocatorSettings.MaxTracesPerFrame)
+	{
+		FLocatorCluster& Cluster = LocatorClusters[NextClusterToTrace++];
+
+		// 代表点与玩家之间没有阻挡即视为该组都能看到玩家，其他敌人的胶囊体不在可见性通道上阻挡
+		Cluster.bHasLineOfSight = !GetWorld()->LineTraceTestByChannel(Cluster.TraceStart, TraceEnd, LocatorSettings.SightTraceChannel, QueryParams);
+
+		NumTraces++;
+	}
+
+	SET_DWORD_STAT(STAT_WarriorHeroTargetLocatorTraces, NumTraces);
+
+	return NextClusterToTrace >= LocatorClusters.Num();
+}
+
+void UWarriorHeroTargetLocatorSubsystem::ApplyLocatorResults(APawn* InHeroPawn)
+{
+	for (const FLocatorCandidate& Candidate : LocatorCandidates)
+	{
+		AWarriorAIController* WarriorAIController = Candidate.AIController.Get();
+
+		if (WarriorAIController && LocatorClusters[Candidate.ClusterIndex].bHasLineOfSight)
+		{
+			WarriorAIController->SetTargetActorIfUnset(InHeroPawn);
+		}
+	}
+}
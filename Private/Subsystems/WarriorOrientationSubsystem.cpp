@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorOrientationSubsystem.h"
+
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Batch Orient To Target"), STAT_WarriorBatchOrientToTarget, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Orient Requests"), STAT_WarriorOrientRequests, STATGROUP_WarriorSurvival);
+
+// 持续转向的请求使用的点积阈值，点积不可能超过1
+static constexpr float NoFacingPrecision = 2.f;
+
+void UWarriorOrientationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SET_DWORD_STAT(STAT_WarriorOrientRequests, RequestIds.Num());
+
+	if (RequestIds.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorBatchOrientToTarget);
+
+	const int32 NumRequests = RequestIds.Num();
+
+	PawnLocations.SetNumUninitialized(NumRequests, EAllowShrinking::No);
+	TargetLocations.SetNumUninitialized(NumRequests, EAllowShrinking::No);
+	PawnRotations.SetNumUninitialized(NumRequests, EAllowShrinking::No);
+	RequestValidFlags.SetNumUninitialized(NumRequests, EAllowShrinking::No);
+	FinishedRequests.Reset();
+
+	// 收集：把角色与目标的位置、当前朝向读到连续数组中
+	for (int32 RequestIndex = 0; RequestIndex < NumRequests; RequestIndex++)
+	{
+		const APawn* Pawn = RequestPawns[RequestIndex].Get();
+		const AActor* TargetActor = RequestTargets[RequestIndex].Get();
+
+		RequestValidFlags[RequestIndex] = Pawn && TargetActor;
+
+		if (!RequestValidFlags[RequestIndex])
+		{
+			PawnLocations[RequestIndex] = FVector::ZeroVector;
+			TargetLocations[RequestIndex] = FVector::ZeroVector;
+			PawnRotations[RequestIndex] = FRotator::ZeroRotator;
+
+			FinishedRequests.Emplace(RequestIds[RequestIndex], false);
+			continue;
+		}
+
+		PawnLocations[RequestIndex] = Pawn->GetActorLocation();
+		TargetLocations[RequestIndex] = TargetActor->GetActorLocation();
+		PawnRotations[RequestIndex] = Pawn->GetActorRotation();
+	}
+
+	// 计算：只读写连续数组，不访问任何 Actor
+	for (int32 RequestIndex = 0; RequestIndex < NumRequests; RequestIndex++)
+	{
+		const FVector ToTarget = TargetLocations[RequestIndex] - PawnLocations[RequestIndex];
+
+		PawnRotations[RequestIndex] = FMath::RInterpTo(PawnRotations[RequestIndex], ToTarget.Rotation(), DeltaTime, RequestInterpSpeeds[RequestIndex]);
+	}
+
+	// 应用并检查是否已朝向目标
+	for (int32 RequestIndex = 0; RequestIndex < NumRequests; RequestIndex++)
+	{
+		if (!RequestValidFlags[RequestIndex])
+		{
+			continue;
+		}
+
+		RequestPawns[RequestIndex]->SetActorRotation(PawnRotations[RequestIndex]);
+
+		const float FacingDot = FVector::DotProduct(PawnRotations[RequestIndex].Vector(),
+			(TargetLocations[RequestIndex] - PawnLocations[RequestIndex]).GetSafeNormal());
+
+		if (FacingDot >= RequestMinFacingDots[RequestIndex])
+		{
+			FinishedRequests.Emplace(RequestIds[RequestIndex], true);
+		}
+	}
+
+	if (FinishedRequests.IsEmpty())
+	{
+		return;
+	}
+
+	// 先移除全部结束的请求再调用回调，回调中可以安全地登记或移除请求
+	FinishedCallbacks.Reset();
+
+	for (const TPair<uint32, bool>& FinishedRequest : FinishedRequests)
+	{
+		if (const int32* RequestIndex = RequestIndexById.Find(FinishedRequest.Key))
+		{
+			FinishedCallbacks.Emplace(MoveTemp(RequestFinishedDelegates[*RequestIndex]), FinishedRequest.Value);
+
+			RemoveOrientRequestAt(*RequestIndex);
+		}
+	}
+
+	for (TPair<FOnOrientRequestFinishedDelegate, bool>& FinishedCallback : FinishedCallbacks)
+	{
+		FinishedCallback.Key.ExecuteIfBound(FinishedCallback.Value);
+	}
+
+	FinishedCallbacks.Reset();
+}
+
+TStatId UWarriorOrientationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorOrientationSubsystem, STATGROUP_Tickables);
+}
+
+uint32 UWarriorOrientationSubsystem::AddOrientRequest(APawn* InPawn, AActor* InTargetActor, float InRotationInterpSpeed,
+	float InAnglePrecision, FOnOrientRequestFinishedDelegate InOnFinished)
+{
+	if (!InPawn || !InTargetActor)
+	{
+		return 0;
+	}
+
+	const uint32 RequestId = NextRequestId++;
+
+	// 编号回绕时跳过0，0表示无效请求
+	if (NextRequestId == 0)
+	{
+		NextRequestId = 1;
+	}
+
+	RequestIndexById.Add(RequestId, RequestIds.Num());
+
+	RequestIds.Add(RequestId);
+	RequestPawns.Add(InPawn);
+	RequestTargets.Add(InTargetActor);
+	RequestInterpSpeeds.Add(InRotationInterpSpeed);
+	RequestMinFacingDots.Add(InAnglePrecision >= 0.f ? FMath::Cos(FMath::DegreesToRadians(InAnglePrecision)) : NoFacingPrecision);
+	RequestFinishedDelegates.Add(MoveTemp(InOnFinished));
+
+	return RequestId;
+}
+
+bool UWarriorOrientationSubsystem::UpdateOrientRequestTarget(uint32 InRequestId, AActor* InTargetActor)
+{
+	const int32* RequestIndex = RequestIndexById.Find(InRequestId);
+
+	if (!RequestIndex)
+	{
+		return false;
+	}
+
+	RequestTargets[*RequestIndex] = InTargetActor;
+
+	return true;
+}
+
+void UWarriorOrientationSubsystem::RemoveOrientRequest(uint32 InRequestId)
+{
+	if (const int32* RequestIndex = RequestIndexById.Find(InRequestId))
+	{
+		RemoveOrientRequestAt(*RequestIndex);
+	}
+}
+
+bool UWarriorOrientationSubsystem::IsFacingTarget(const APawn* InPawn, const AActor* InTargetActor, float InAnglePrecision)
+{
+	const FVector OwnerToTargetNormalized = (InTargetActor->GetActorLocation() - InPawn->GetActorLocation()).GetSafeNormal();
+
+	// 比较余弦而不是反余弦后的角度
+	return FVector::DotProduct(InPawn->GetActorForwardVector(), OwnerToTargetNormalized) >= FMath::Cos(FMath::DegreesToRadians(InAnglePrecision));
+}
+
+void UWarriorOrientationSubsystem::RemoveOrientRequestAt(int32 InRequestIndex)
+{
+	RequestIndexById.Remove(RequestIds[InRequestIndex]);
+
+	RequestIds.RemoveAtSwap(InRequestIndex, 1, EAllowShrinking::No);
+	RequestPawns.RemoveAtSwap(InRequestIndex, 1, EAllowShrinking::No);
+	RequestTargets.RemoveAtSwap(InRequestIndex, 1, EAllowShrinking::No);
+	RequestInterpSpeeds.RemoveAtSwap(InRequestIndex, 1, EAllowShrinking::No);
+	RequestMinFacingDots.RemoveAtSwap(InRequestIndex, 1, EAllowShrinking::No);
+	RequestFinishedDelegates.RemoveAtSwap(InRequestIndex, 1, EAllowShrinking::No);
+
+	if (RequestIds.IsValidIndex(InRequestIndex))
+	{
+		RequestIndexById[RequestIds[InRequestIndex]] = InRequestIndex;
+	}
+}
@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorPopulationDirectorSubsystem.h"
+
+#include "RenderCore.h"
+#include "WarriorStats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Concurrent Enemy Cap"), STAT_WarriorConcurrentEnemyCap, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Deferred Enemy Spawns"), STAT_WarriorDeferredEnemySpawns, STATGROUP_WarriorSurvival);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Smoothed Game Thread (ms)"), STAT_WarriorSmoothedGameThreadMs, STATGROUP_WarriorSurvival);
+
+void UWarriorPopulationDirectorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		DirectorSettings = BaseGameMode->GetPopulationDirectorSettings();
+	}
+
+	DirectorSettings.MinConcurrentEnemies = FMath::Min(DirectorSettings.MinConcurrentEnemies, DirectorSettings.MaxConcurrentEnemies);
+
+	// 从上限开始，由实际帧时间决定是否下调
+	ConcurrentEnemyCap = DirectorSettings.MaxConcurrentEnemies;
+	SmoothedGameThreadMs = 0.f;
+
+	DirectorStats = FWarriorPopulationDirectorStats();
+	DirectorStats.ConcurrentEnemyCap = ConcurrentEnemyCap;
+
+	SET_DWORD_STAT(STAT_WarriorConcurrentEnemyCap, ConcurrentEnemyCap);
+}
+
+void UWarriorPopulationDirectorSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// GGameThreadTime 在视口绘制时更新，-nullrhi 下可能为0，此时以整帧时间为准
+	float GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+	if (GameThreadMs <= 0.f)
+	{
+		GameThreadMs = DeltaTime * 1000.f;
+	}
+
+	SmoothedGameThreadMs = SmoothedGameThreadMs <= 0.f ? GameThreadMs
+		: FMath::Lerp(SmoothedGameThreadMs, GameThreadMs, DirectorSettings.FrameTimeSmoothingAlpha);
+
+	DirectorStats.SmoothedGameThreadMs = SmoothedGameThreadMs;
+	SET_FLOAT_STAT(STAT_WarriorSmoothedGameThreadMs, SmoothedGameThreadMs);
+
+	TimeSinceLastCapAdjust += DeltaTime;
+
+	if (TimeSinceLastCapAdjust >= DirectorSettings.CapAdjustInterval)
+	{
+		TimeSinceLastCapAdjust = 0.f;
+
+		AdjustConcurrentEnemyCap();
+	}
+}
+
+TStatId UWarriorPopulationDirectorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorPopulationDirectorSubsystem, STATGROUP_Tickables);
+}
+
+bool UWarriorPopulationDirectorSubsystem::RequestSpawnSlot(int32 InNumLiveEnemies)
+{
+	if (InNumLiveEnemies < ConcurrentEnemyCap)
+	{
+		return true;
+	}
+
+	DirectorStats.DeferredSpawnDecisions++;
+	INC_DWORD_STAT(STAT_WarriorDeferredEnemySpawns);
+
+	return false;
+}
+
+void UWarriorPopulationDirectorSubsystem::AdjustConcurrentEnemyCap()
+{
+	int32 NewConcurrentEnemyCap = ConcurrentEnemyCap;
+
+	if (SmoothedGameThreadMs > DirectorSettings.GameThreadBudgetMs)
+	{
+		NewConcurrentEnemyCap = FMath::Max(ConcurrentEnemyCap - DirectorSettings.CapAdjustStep, DirectorSettings.MinConcurrentEnemies);
+	}
+	else if (SmoothedGameThreadMs < DirectorSettings.GameThreadBudgetMs * DirectorSettings.RaiseCapBudgetRatio)
+	{
+		NewConcurrentEnemyCap = FMath::Min(ConcurrentEnemyCap + DirectorSettings.CapAdjustStep, DirectorSettings.MaxConcurrentEnemies);
+	}
+
+	if (NewConcurrentEnemyCap == ConcurrentEnemyCap)
+	{
+		return;
+	}
+
+	if (NewConcurrentEnemyCap > ConcurrentEnemyCap)
+	{
+		DirectorStats.CapRaisedCount++;
+	}
+	else
+	{
+		DirectorStats.CapLoweredCount++;
+	}
+
+	ConcurrentEnemyCap = NewConcurrentEnemyCap;
+	DirectorStats.ConcurrentEnemyCap = ConcurrentEnemyCap;
+
+	SET_DWORD_STAT(STAT_WarriorConcurrentEnemyCap, ConcurrentEnemyCap);
+
+	OnConcurrentEnemyCapChanged.Broadcast(ConcurrentEnemyCap);
+}
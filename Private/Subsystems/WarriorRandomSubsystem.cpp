@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorRandomSubsystem.h"
+
+void UWarriorRandomSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bSeededMode = FParse::Value(FCommandLine::Get(), TEXT("WarriorSeed="), BaseSeed);
+
+	if (!bSeededMode)
+	{
+		BaseSeed = FMath::Rand();
+	}
+
+	// 每个流使用不同的派生种子，某一处多消耗一个随机数不会影响其他流的序列
+	for (int32 StreamIndex = 0; StreamIndex < UE_ARRAY_COUNT(RandomStreams); StreamIndex++)
+	{
+		RandomStreams[StreamIndex].Initialize(static_cast<int32>(HashCombine(static_cast<uint32>(BaseSeed), static_cast<uint32>(StreamIndex))));
+	}
+
+	if (bSeededMode)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Warrior seeded mode enabled for %s, seed %i"), *GetWorld()->GetName(), BaseSeed);
+	}
+}
+
+int32 UWarriorRandomSubsystem::RandRange(const UObject* WorldContextObject, EWarriorRandomStream InStream, int32 InMin, int32 InMax)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+
+	if (UWarriorRandomSubsystem* RandomSubsystem = World ? World->GetSubsystem<UWarriorRandomSubsystem>() : nullptr)
+	{
+		return RandomSubsystem->GetStream(InStream).RandRange(InMin, InMax);
+	}
+
+	return FMath::RandRange(InMin, InMax);
+}
@@ -0,0 +1,371 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorSoakBenchmarkSubsystem.h"
+
+#include "EngineUtils.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "UObject/UObjectArray.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorGameplayTags.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "GameModes/WarriorSurvivalGameMode.h"
+#include "Kismet/GameplayStatics.h"
+
+bool UWarriorSoakBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Param(FCommandLine::Get(), TEXT("WarriorSoak"));
+}
+
+void UWarriorSoakBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorSoakBaseline="), BaselineFilePath);
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorSoakTolerance="), RegressionTolerance);
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorSoakKillInterval="), KillIntervalSeconds);
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorSoakWaveTimeScale="), WaveFlowTimeScale);
+	FParse::Value(FCommandLine::Get(), TEXT("WarriorSoakTimeout="), TimeoutSeconds);
+}
+
+bool UWarriorSoakBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UWarriorSoakBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorSoakBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorSoakBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bSoakRunFinished)
+	{
+		return;
+	}
+
+	if (!bSoakRunStarted)
+	{
+		BeginSoakRun();
+
+		if (!bSoakRunStarted)
+		{
+			return;
+		}
+	}
+
+	const double NowSeconds = FPlatformTime::Seconds();
+	const float FrameTimeMs = static_cast<float>((NowSeconds - LastFrameTimeSeconds) * 1000.0);
+
+	LastFrameTimeSeconds = NowSeconds;
+
+	const EWarriorSurvivalGameModeState CurrentState = SurvivalGameMode->GetCurrentSurvivalGameModeState();
+
+	if (!bRecordingWave && CurrentState == EWarriorSurvivalGameModeState::SpawningNewWave)
+	{
+		BeginWaveRecording(SurvivalGameMode->GetCurrentWaveCount());
+	}
+
+	if (bRecordingWave)
+	{
+		RecordFrame(FrameTimeMs);
+
+		if (CurrentState != EWarriorSurvivalGameModeState::SpawningNewWave && CurrentState != EWarriorSurvivalGameModeState::InProgress)
+		{
+			EndWaveRecording();
+		}
+	}
+
+	if (CurrentState == EWarriorSurvivalGameModeState::InProgress)
+	{
+		TimeSinceLastKill += DeltaTime;
+
+		if (TimeSinceLastKill >= KillIntervalSeconds)
+		{
+			TimeSinceLastKill = 0.f;
+
+			KillOneLiveEnemy();
+		}
+	}
+
+	if (CurrentState == EWarriorSurvivalGameModeState::AllWavesDone)
+	{
+		FinishSoakRun(TEXT("AllWavesDone"));
+	}
+	else if (CurrentState == EWarriorSurvivalGameModeState::PlayerDied)
+	{
+		FinishSoakRun(TEXT("PlayerDied"));
+	}
+	else if (NowSeconds - SoakStartTimeSeconds >= TimeoutSeconds)
+	{
+		FinishSoakRun(TEXT("Timeout"));
+	}
+}
+
+void UWarriorSoakBenchmarkSubsystem::BeginSoakRun()
+{
+	SurvivalGameMode = GetWorld()->GetAuthGameMode<AWarriorSurvivalGameMode>();
+
+	if (!SurvivalGameMode)
+	{
+		return;
+	}
+
+	// 无界面运行时没有玩家输入，英雄只负责存在，伤害由无敌标签屏蔽
+	if (APawn* HeroPawn = UGameplayStatics::GetPlayerPawn(this, 0))
+	{
+		UWarriorFunctionLibrary::AddGameplayTagToActorIfNone(HeroPawn, WarriorGameplayTags::Shared_Status_Invincible);
+	}
+
+	SurvivalGameMode->WarriorSetWaveFlowTimeScale(WaveFlowTimeScale);
+
+	SoakStartTimeSeconds = FPlatformTime::Seconds();
+	LastFrameTimeSeconds = SoakStartTimeSeconds;
+
+	bSoakRunStarted = true;
+
+	UE_LOG(LogTemp, Display, TEXT("Warrior soak run started on %s, %i waves"), *GetWorld()->GetMapName(), SurvivalGameMode->GetTotalWavesToSpawn());
+}
+
+void UWarriorSoakBenchmarkSubsystem::BeginWaveRecording(int32 InWaveCount)
+{
+	CurrentWaveReport = FWarriorSoakWaveReport();
+	CurrentWaveReport.WaveCount = InWaveCount;
+
+	CurrentWaveFrameTimesMs.Reset();
+	CurrentWaveGameThreadTimesMs.Reset();
+
+	WaveStartTimeSeconds = FPlatformTime::Seconds();
+	LastSpawnedFromQueue = SurvivalGameMode->GetEnemySpawnQueueStats().SpawnedFromQueue;
+	FramesSinceMemorySample = 0;
+	TimeSinceLastKill = 0.f;
+
+	bRecordingWave = true;
+}
+
+void UWarriorSoakBenchmarkSubsystem::RecordFrame(float InFrameTimeMs)
+{
+	CurrentWaveFrameTimesMs.Add(InFrameTimeMs);
+
+	// 无头运行时没有视口绘制，GGameThreadTime 不会更新
+	const float GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+	CurrentWaveGameThreadTimesMs.Add(GameThreadMs > 0.f ? GameThreadMs : InFrameTimeMs);
+
+	// 队列统计在波次结束时会被清零，只在计数增加时视为本帧有敌人生成
+	const int32 SpawnedFromQueue = SurvivalGameMode->GetEnemySpawnQueueStats().SpawnedFromQueue;
+
+	if (SpawnedFromQueue > LastSpawnedFromQueue)
+	{
+		CurrentWaveReport.MaxSpawnHitchMs = FMath::Max(CurrentWaveReport.MaxSpawnHitchMs, InFrameTimeMs);
+	}
+
+	LastSpawnedFromQueue = SpawnedFromQueue;
+
+	CurrentWaveReport.MaxLiveObjects = FMath::Max(CurrentWaveReport.MaxLiveObjects, GUObjectArray.GetObjectArrayNumMinusAvailable());
+	CurrentWaveReport.MaxLiveActors = FMath::Max(CurrentWaveReport.MaxLiveActors, GetWorld()->GetActorCount());
+
+	// 读取内存统计的开销较大，隔一段时间采样一次
+	if (FramesSinceMemorySample-- <= 0)
+	{
+		FramesSinceMemorySample = 30;
+
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+		CurrentWaveReport.PeakUsedPhysicalMB = FMath::Max(CurrentWaveReport.PeakUsedPhysicalMB,
+			static_cast<float>(MemoryStats.UsedPhysical / (1024.0 * 1024.0)));
+	}
+}
+
+void UWarriorSoakBenchmarkSubsystem::EndWaveRecording()
+{
+	bRecordingWave = false;
+
+	CurrentWaveFrameTimesMs.Sort();
+	CurrentWaveGameThreadTimesMs.Sort();
+
+	CurrentWaveReport.NumFrames = CurrentWaveFrameTimesMs.Num();
+	CurrentWaveReport.WaveDurationSeconds = static_cast<float>(FPlatformTime::Seconds() - WaveStartTimeSeconds);
+	CurrentWaveReport.FrameTimeP50Ms = GetPercentile(CurrentWaveFrameTimesMs, 0.50f);
+	CurrentWaveReport.FrameTimeP95Ms = GetPercentile(CurrentWaveFrameTimesMs, 0.95f);
+	CurrentWaveReport.FrameTimeP99Ms = GetPercentile(CurrentWaveFrameTimesMs, 0.99f);
+	CurrentWaveReport.FrameTimeMaxMs = CurrentWaveFrameTimesMs.IsEmpty() ? 0.f : CurrentWaveFrameTimesMs.Last();
+	CurrentWaveReport.GameThreadTimeP95Ms = GetPercentile(CurrentWaveGameThreadTimesMs, 0.95f);
+
+	WaveReports.Add(CurrentWaveReport);
+
+	UE_LOG(LogTemp, Display, TEXT("Warrior soak wave %i: %i frames, p50 %.2fms, p95 %.2fms, p99 %.2fms, spawn hitch %.2fms, peak %.1fMB"),
+		CurrentWaveReport.WaveCount, CurrentWaveReport.NumFrames, CurrentWaveReport.FrameTimeP50Ms, CurrentWaveReport.FrameTimeP95Ms,
+		CurrentWaveReport.FrameTimeP99Ms, CurrentWaveReport.MaxSpawnHitchMs, CurrentWaveReport.PeakUsedPhysicalMB);
+}
+
+void UWarriorSoakBenchmarkSubsystem::KillOneLiveEnemy()
+{
+	for (TActorIterator<AWarriorEnemyCharacter> It(GetWorld()); It; ++It)
+	{
+		AWarriorEnemyCharacter* LiveEnemy = *It;
+
+		// 隐藏的敌人正在对象池中休眠
+		if (!IsValid(LiveEnemy) || LiveEnemy->IsHidden() || UWarriorFunctionLibrary::NativeDoesActorHaveTag(LiveEnemy, WarriorGameplayTags::Shared_Status_Dead))
+		{
+			continue;
+		}
+
+		LiveEnemy->FinishDeath();
+
+		return;
+	}
+}
+
+void UWarriorSoakBenchmarkSubsystem::FinishSoakRun(const FString& InReason)
+{
+	if (bRecordingWave)
+	{
+		EndWaveRecording();
+	}
+
+	bSoakRunFinished = true;
+
+	const FString BaseFileName = FString::Printf(TEXT("SoakReport_%s_%s"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString());
+
+	WriteReports(BaseFileName);
+
+	const int32 NumRegressions = CompareAgainstBaseline();
+
+	UE_LOG(LogTemp, Display, TEXT("Warrior soak run finished (%s): %i waves recorded, %i regressions"), *InReason, WaveReports.Num(), NumRegressions);
+
+	if (GetWorld()->WorldType == EWorldType::Game)
+	{
+		const bool bSucceeded = NumRegressions == 0 && InReason == TEXT("AllWavesDone");
+
+		FPlatformMisc::RequestExitWithStatus(false, bSucceeded ? 0 : 1);
+	}
+}
+
+void UWarriorSoakBenchmarkSubsystem::WriteReports(const FString& InBaseFileName) const
+{
+	const FString ReportDirectory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("WarriorSoak"));
+
+	FString CsvReport = TEXT("WaveCount,NumFrames,WaveDurationSeconds,FrameTimeP50Ms,FrameTimeP95Ms,FrameTimeP99Ms,FrameTimeMaxMs,GameThreadTimeP95Ms,MaxSpawnHitchMs,MaxLiveObjects,MaxLiveActors,PeakUsedPhysicalMB\n");
+	FString JsonReport = FString::Printf(TEXT("{\n\t\"map\": \"%s\",\n\t\"waves\": [\n"), *GetWorld()->GetMapName());
+
+	for (int32 ReportIndex = 0; ReportIndex < WaveReports.Num(); ReportIndex++)
+	{
+		const FWarriorSoakWaveReport& Report = WaveReports[ReportIndex];
+
+		CsvReport += FString::Printf(TEXT("%i,%i,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%i,%i,%.1f\n"),
+			Report.WaveCount, Report.NumFrames, Report.WaveDurationSeconds, Report.FrameTimeP50Ms, Report.FrameTimeP95Ms,
+			Report.FrameTimeP99Ms, Report.FrameTimeMaxMs, Report.GameThreadTimeP95Ms, Report.MaxSpawnHitchMs,
+			Report.MaxLiveObjects, Report.MaxLiveActors, Report.PeakUsedPhysicalMB);
+
+		JsonReport += FString::Printf(TEXT("\t\t{ \"wave\": %i, \"frames\": %i, \"durationSeconds\": %.3f, \"frameTimeP50Ms\": %.3f, \"frameTimeP95Ms\": %.3f, ")
+			TEXT("\"frameTimeP99Ms\": %.3f, \"frameTimeMaxMs\": %.3f, \"gameThreadTimeP95Ms\": %.3f, \"maxSpawnHitchMs\": %.3f, ")
+			TEXT("\"maxLiveObjects\": %i, \"maxLiveActors\": %i, \"peakUsedPhysicalMB\": %.1f }%s\n"),
+			Report.WaveCount, Report.NumFrames, Report.WaveDurationSeconds, Report.FrameTimeP50Ms, Report.FrameTimeP95Ms,
+			Report.FrameTimeP99Ms, Report.FrameTimeMaxMs, Report.GameThreadTimeP95Ms, Report.MaxSpawnHitchMs,
+			Report.MaxLiveObjects, Report.MaxLiveActors, Report.PeakUsedPhysicalMB,
+			ReportIndex + 1 < WaveReports.Num() ? TEXT(",") : TEXT(""));
+	}
+
+	JsonReport += TEXT("\t]\n}\n");
+
+	const FString CsvFilePath = FPaths::Combine(ReportDirectory, InBaseFileName + TEXT(".csv"));
+	const FString JsonFilePath = FPaths::Combine(ReportDirectory, InBaseFileName + TEXT(".json"));
+
+	FFileHelper::SaveStringToFile(CsvReport, *CsvFilePath);
+	FFileHelper::SaveStringToFile(JsonReport, *JsonFilePath);
+
+	UE_LOG(LogTemp, Display, TEXT("Warrior soak report written to %s"), *CsvFilePath);
+}
+
+int32 UWarriorSoakBenchmarkSubsystem::CompareAgainstBaseline() const
+{
+	if (BaselineFilePath.IsEmpty())
+	{
+		return 0;
+	}
+
+	TArray<FString> BaselineLines;
+
+	if (!FFileHelper::LoadFileToStringArray(BaselineLines, *BaselineFilePath) || BaselineLines.Num() < 2)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Warrior soak baseline %s could not be read"), *BaselineFilePath);
+		return 0;
+	}
+
+	TArray<FString> ColumnNames;
+	BaselineLines[0].ParseIntoArray(ColumnNames, TEXT(","));
+
+	const int32 WaveColumn = ColumnNames.IndexOfByKey(TEXT("WaveCount"));
+	const int32 FrameTimeP95Column = ColumnNames.IndexOfByKey(TEXT("FrameTimeP95Ms"));
+	const int32 SpawnHitchColumn = ColumnNames.IndexOfByKey(TEXT("MaxSpawnHitchMs"));
+	const int32 PeakMemoryColumn = ColumnNames.IndexOfByKey(TEXT("PeakUsedPhysicalMB"));
+
+	if (WaveColumn == INDEX_NONE || FrameTimeP95Column == INDEX_NONE || SpawnHitchColumn == INDEX_NONE || PeakMemoryColumn == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Warrior soak baseline %s is missing required columns"), *BaselineFilePath);
+		return 0;
+	}
+
+	int32 NumRegressions = 0;
+
+	auto CheckMetric = [this, &NumRegressions](int32 InWaveCount, const TCHAR* InMetricName, float InCurrentValue, float InBaselineValue)
+	{
+		if (InBaselineValue > 0.f && InCurrentValue > InBaselineValue * (1.f + RegressionTolerance))
+		{
+			NumRegressions++;
+
+			UE_LOG(LogTemp, Warning, TEXT("Warrior soak regression in wave %i: %s %.3f exceeds baseline %.3f by more than %.0f%%"),
+				InWaveCount, InMetricName, InCurrentValue, InBaselineValue, RegressionTolerance * 100.f);
+		}
+	};
+
+	for (int32 LineIndex = 1; LineIndex < BaselineLines.Num(); LineIndex++)
+	{
+		TArray<FString> Values;
+		BaselineLines[LineIndex].ParseIntoArray(Values, TEXT(","));
+
+		if (Values.Num() < ColumnNames.Num())
+		{
+			continue;
+		}
+
+		const int32 WaveCount = FCString::Atoi(*Values[WaveColumn]);
+
+		const FWarriorSoakWaveReport* Report = WaveReports.FindByPredicate(
+			[WaveCount](const FWarriorSoakWaveReport& InReport)
+			{
+				return InReport.WaveCount == WaveCount;
+			}
+		);
+
+		if (!Report)
+		{
+			continue;
+		}
+
+		CheckMetric(WaveCount, TEXT("FrameTimeP95Ms"), Report->FrameTimeP95Ms, FCString::Atof(*Values[FrameTimeP95Column]));
+		CheckMetric(WaveCount, TEXT("MaxSpawnHitchMs"), Report->MaxSpawnHitchMs, FCString::Atof(*Values[SpawnHitchColumn]));
+		CheckMetric(WaveCount, TEXT("PeakUsedPhysicalMB"), Report->PeakUsedPhysicalMB, FCString::Atof(*Values[PeakMemoryColumn]));
+	}
+
+	return NumRegressions;
+}
+
+float UWarriorSoakBenchmarkSubsystem::GetPercentile(const TArray<float>& InSortedSamples, float InPercentile)
+{
+	if (InSortedSamples.IsEmpty())
+	{
+		return 0.f;
+	}
+
+	const int32 SampleIndex = FMath::Clamp(FMath::CeilToInt(InPercentile * InSortedSamples.Num()) - 1, 0, InSortedSamples.Num() - 1);
+
+	return InSortedSamples[SampleIndex];
+}
@@ -0,0 +1,249 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorSpawnPointSubsystem.h"
+
+#include "EngineUtils.h"
+#include "NavigationSystem.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/TargetPoint.h"
+#include "Subsystems/WarriorRandomSubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Rebuild Spawn Point Cache"), STAT_WarriorRebuildSpawnPointCache, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cached Spawn Points"), STAT_WarriorCachedSpawnPoints, STATGROUP_WarriorSurvival);
+
+void UWarriorSpawnPointSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		CacheSettings = BaseGameMode->GetSpawnPointCacheSettings();
+	}
+
+	// 动态导航网格在运行时重建完成后，旧的采样点可能已经不可达
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &ThisClass::OnNavigationGenerationFinished);
+	}
+
+	RebuildSpawnPointCache();
+}
+
+void UWarriorSpawnPointSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &ThisClass::OnNavigationGenerationFinished);
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(NavigationRebuildTimerHandle);
+	}
+
+	SET_DWORD_STAT(STAT_WarriorCachedSpawnPoints, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorSpawnPointSubsystem::RebuildSpawnPointCache()
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorRebuildSpawnPointCache);
+
+	SpawnAnchors.Reset();
+	CachedGroundLocations.Reset();
+
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+
+	const UWarriorRandomSubsystem* RandomSubsystem = World->GetSubsystem<UWarriorRandomSubsystem>();
+	const uint32 BaseSeed = RandomSubsystem ? static_cast<uint32>(RandomSubsystem->GetBaseSeed()) : 0;
+
+	for (TActorIterator<ATargetPoint> It(World); It; ++It)
+	{
+		const ATargetPoint* TargetPoint = *It;
+
+		FWarriorSpawnAnchor& Anchor = SpawnAnchors.AddDefaulted_GetRef();
+		Anchor.AnchorLocation = TargetPoint->GetActorLocation();
+		Anchor.AnchorRotation = TargetPoint->GetActorForwardVector().ToOrientationRotator();
+		Anchor.FirstPointIndex = CachedGroundLocations.Num();
+
+		// 每个锚点使用独立派生的随机流，导航网格重建后重新采样得到的点与第一次完全相同
+		FRandomStream AnchorRandomStream(static_cast<int32>(HashCombine(BaseSeed, static_cast<uint32>(SpawnAnchors.Num()))));
+
+		FNavLocation AnchorNavLocation;
+		const bool bAnchorOnNavMesh = NavData && NavSys->ProjectPointToNavigation(Anchor.AnchorLocation, AnchorNavLocation,
+			FVector(50.f, 50.f, CacheSettings.GroundTraceDownDistance), NavData);
+
+		const int32 MaxSampleAttempts = CacheSettings.SpawnPointsPerTargetPoint * 4;
+
+		for (int32 Attempt = 0; bAnchorOnNavMesh && Attempt < MaxSampleAttempts; Attempt++)
+		{
+			if (CachedGroundLocations.Num() - Anchor.FirstPointIndex >= CacheSettings.SpawnPointsPerTargetPoint)
+			{
+				break;
+			}
+
+			FNavLocation NavLocation;
+
+			if (!TrySampleNavigablePoint(Anchor.AnchorLocation, CacheSettings.SampleRadius, AnchorRandomStream, NavLocation))
+			{
+				continue;
+			}
+
+			// 只保留能从锚点走到的点，排除半径内孤立的导航岛
+			FPathFindingQuery PathQuery(this, *NavData, AnchorNavLocation.Location, NavLocation.Location);
+
+			if (!NavSys->TestPathSync(PathQuery))
+			{
+				continue;
+			}
+
+			FVector GroundLocation;
+
+			if (TrySnapToGround(NavLocation.Location, GroundLocation))
+			{
+				CachedGroundLocations.Add(GroundLocation);
+			}
+		}
+
+		// 导航网格尚未生成时至少保留锚点自身，保证生成流程可用
+		if (CachedGroundLocations.Num() == Anchor.FirstPointIndex)
+		{
+			FVector GroundLocation;
+
+			CachedGroundLocations.Add(TrySnapToGround(Anchor.AnchorLocation, GroundLocation) ? GroundLocation : Anchor.AnchorLocation);
+		}
+
+		Anchor.NumPoints = CachedGroundLocations.Num() - Anchor.FirstPointIndex;
+	}
+
+	SET_DWORD_STAT(STAT_WarriorCachedSpawnPoints, CachedGroundLocations.Num());
+}
+
+bool UWarriorSpawnPointSubsystem::PickWaveSpawnPoint(FVector& OutGroundLocation, FRotator& OutRotation) const
+{
+	if (SpawnAnchors.IsEmpty())
+	{
+		return false;
+	}
+
+	FRandomStream& SpawnPointStream = GetWorld()->GetSubsystem<UWarriorRandomSubsystem>()->GetStream(EWarriorRandomStream::SpawnPoint);
+
+	const FWarriorSpawnAnchor& Anchor = SpawnAnchors[SpawnPointStream.RandRange(0, SpawnAnchors.Num() - 1)];
+
+	OutGroundLocation = CachedGroundLocations[Anchor.FirstPointIndex + SpawnPointStream.RandRange(0, Anchor.NumPoints - 1)];
+	OutRotation = Anchor.AnchorRotation;
+
+	return true;
+}
+
+bool UWarriorSpawnPointSubsystem::FindSpawnPointNear(const FVector& InOrigin, float InRadius, FVector& OutGroundLocation) const
+{
+	const float RadiusSquared = FMath::Square(InRadius);
+
+	FRandomStream& SpawnPointStream = GetWorld()->GetSubsystem<UWarriorRandomSubsystem>()->GetStream(EWarriorRandomStream::SpawnPoint);
+
+	int32 NumCandidates = 0;
+
+	// 蓄水池抽样，单次遍历即可在半径内等概率选出一个点
+	for (const FVector& CachedLocation : CachedGroundLocations)
+	{
+		if (FVector::DistSquared2D(CachedLocation, InOrigin) > RadiusSquared)
+		{
+			continue;
+		}
+
+		NumCandidates++;
+
+		if (SpawnPointStream.RandRange(1, NumCandidates) == 1)
+		{
+			OutGroundLocation = CachedLocation;
+		}
+	}
+
+	if (NumCandidates > 0)
+	{
+		return true;
+	}
+
+	FNavLocation NavLocation;
+
+	if (TrySampleNavigablePoint(InOrigin, InRadius, SpawnPointStream, NavLocation))
+	{
+		if (!TrySnapToGround(NavLocation.Location, OutGroundLocation))
+		{
+			OutGroundLocation = NavLocation.Location;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+FVector UWarriorSpawnPointSubsystem::GetSpawnLocationForEnemyClass(const FVector& InGroundLocation, const UClass* InEnemyClass)
+{
+	float CapsuleHalfHeight = 0.f;
+
+	if (const AWarriorEnemyCharacter* EnemyCDO = InEnemyClass ? InEnemyClass->GetDefaultObject<AWarriorEnemyCharacter>() : nullptr)
+	{
+		CapsuleHalfHeight = EnemyCDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	}
+
+	// 预留少量间隙，避免胶囊体底部与地面重叠导致生成位置被挤开
+	return InGroundLocation + FVector(0.f, 0.f, CapsuleHalfHeight + 2.f);
+}
+
+void UWarriorSpawnPointSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	if (CacheSettings.NavigationRebuildDelay <= 0.f)
+	{
+		RebuildSpawnPointCache();
+		return;
+	}
+
+	// 每次重建完成都重新开始计时，连续的重建只在最后一次之后重新采样一次
+	GetWorld()->GetTimerManager().SetTimer(NavigationRebuildTimerHandle, this, &ThisClass::RebuildSpawnPointCache,
+		CacheSettings.NavigationRebuildDelay, false);
+}
+
+bool UWarriorSpawnPointSubsystem::TrySampleNavigablePoint(const FVector& InOrigin, float InRadius, FRandomStream& InRandomStream,
+	FNavLocation& OutNavLocation) const
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!NavSys)
+	{
+		return false;
+	}
+
+	// 在圆盘内均匀取点再投影到导航网格，随机数全部来自传入的流以保证可复现
+	const float Angle = InRandomStream.FRandRange(0.f, 2.f * PI);
+	const float Distance = InRadius * FMath::Sqrt(InRandomStream.FRand());
+	const FVector Candidate = InOrigin + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.f);
+
+	return NavSys->ProjectPointToNavigation(Candidate, OutNavLocation, FVector(50.f, 50.f, CacheSettings.GroundTraceDownDistance));
+}
+
+bool UWarriorSpawnPointSubsystem::TrySnapToGround(const FVector& InLocation, FVector& OutGroundLocation) const
+{
+	const FVector TraceStart = InLocation + FVector(0.f, 0.f, CacheSettings.GroundTraceUpDistance);
+	const FVector TraceEnd = InLocation - FVector(0.f, 0.f, CacheSettings.GroundTraceDownDistance);
+
+	FHitResult GroundHit;
+
+	const bool bHit = GetWorld()->LineTraceSingleByObjectType(GroundHit, TraceStart, TraceEnd,
+		FCollisionObjectQueryParams(ECC_WorldStatic), FCollisionQueryParams(SCENE_QUERY_STAT(WarriorSpawnPointGroundTrace)));
+
+	if (bHit)
+	{
+		OutGroundLocation = GroundHit.ImpactPoint;
+	}
+
+	return bHit;
+}
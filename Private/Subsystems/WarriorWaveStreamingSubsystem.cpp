@@ -0,0 +1,262 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorWaveStreamingSubsystem.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/WarriorEnemyPoolSubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Retained Enemy Classes"), STAT_WarriorRetainedEnemyClasses, STATGROUP_WarriorSurvival);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Retained Enemy Class Memory (MB)"), STAT_WarriorRetainedEnemyClassMemoryMB, STATGROUP_WarriorSurvival);
+
+void UWarriorWaveStreamingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (const AWarriorBaseGameMode* BaseGameMode = InWorld.GetAuthGameMode<AWarriorBaseGameMode>())
+	{
+		StreamingSettings = BaseGameMode->GetWaveStreamingSettings();
+	}
+}
+
+void UWarriorWaveStreamingSubsystem::Deinitialize()
+{
+	for (int32 EnemyClassIndex = 0; EnemyClassIndex < EnemyClassHandles.Num(); EnemyClassIndex++)
+	{
+		ReleaseEnemyClass(EnemyClassIndex);
+	}
+
+	Super::Deinitialize();
+}
+
+void UWarriorWaveStreamingSubsystem::InitializeWaveSchedule(const FWarriorCompiledWaveSchedule& InWaveSchedule)
+{
+	for (int32 EnemyClassIndex = 0; EnemyClassIndex < EnemyClassHandles.Num(); EnemyClassIndex++)
+	{
+		ReleaseEnemyClass(EnemyClassIndex);
+	}
+
+	WaveSchedule = InWaveSchedule;
+
+	const int32 NumEnemyClasses = WaveSchedule.EnemyClasses.Num();
+
+	EnemyClassHandles.Init(nullptr, NumEnemyClasses);
+	LoadedEnemyClasses.Init(nullptr, NumEnemyClasses);
+	FailedEnemyClasses.Init(false, NumEnemyClasses);
+
+	CurrentWaveIndex = 0;
+}
+
+void UWarriorWaveStreamingSubsystem::UpdateStreaming(int32 InCurrentWaveIndex)
+{
+	CurrentWaveIndex = InCurrentWaveIndex;
+
+	TArray<bool> RequiredEnemyClasses;
+	RequiredEnemyClasses.Init(false, WaveSchedule.EnemyClasses.Num());
+
+	const int64 MemoryBudgetBytes = static_cast<int64>(StreamingSettings.MemoryBudgetMB * 1024.f * 1024.f);
+	const int32 LastWaveIndex = FMath::Min(CurrentWaveIndex + StreamingSettings.LookaheadWaves, WaveSchedule.GetNumWaves() - 1);
+
+	int64 RequiredMemoryBytes = 0;
+
+	for (int32 WaveIndex = CurrentWaveIndex; WaveIndex <= LastWaveIndex; WaveIndex++)
+	{
+		const FWarriorCompiledWavePlan& WavePlan = WaveSchedule.WavePlans[WaveIndex];
+
+		int64 AdditionalMemoryBytes = 0;
+
+		for (int32 UsageIndex = WavePlan.FirstClassUsageIndex; UsageIndex < WavePlan.FirstClassUsageIndex + WavePlan.NumClassUsages; UsageIndex++)
+		{
+			const int32 EnemyClassIndex = WaveSchedule.ClassUsages[UsageIndex].EnemyClassIndex;
+
+			if (!RequiredEnemyClasses[EnemyClassIndex])
+			{
+				AdditionalMemoryBytes += GetEstimatedClassMemoryBytes(EnemyClassIndex);
+			}
+		}
+
+		// 当前波次无论如何都要加载，之后的波次一旦超出预算就停止预取
+		if (WaveIndex > CurrentWaveIndex && RequiredMemoryBytes + AdditionalMemoryBytes > MemoryBudgetBytes)
+		{
+			break;
+		}
+
+		for (int32 UsageIndex = WavePlan.FirstClassUsageIndex; UsageIndex < WavePlan.FirstClassUsageIndex + WavePlan.NumClassUsages; UsageIndex++)
+		{
+			RequiredEnemyClasses[WaveSchedule.ClassUsages[UsageIndex].EnemyClassIndex] = true;
+		}
+
+		RequiredMemoryBytes += AdditionalMemoryBytes;
+	}
+
+	for (int32 EnemyClassIndex = 0; EnemyClassIndex < RequiredEnemyClasses.Num(); EnemyClassIndex++)
+	{
+		if (RequiredEnemyClasses[EnemyClassIndex])
+		{
+			RequestEnemyClassLoad(EnemyClassIndex);
+		}
+		else
+		{
+			ReleaseEnemyClass(EnemyClassIndex);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WarriorRetainedEnemyClasses, GetNumLoadedEnemyClasses());
+	SET_FLOAT_STAT(STAT_WarriorRetainedEnemyClassMemoryMB, GetRetainedMemoryMB());
+}
+
+bool UWarriorWaveStreamingSubsystem::IsWaveReady(int32 InWaveIndex) const
+{
+	if (!WaveSchedule.WavePlans.IsValidIndex(InWaveIndex))
+	{
+		return false;
+	}
+
+	const FWarriorCompiledWavePlan& WavePlan = WaveSchedule.WavePlans[InWaveIndex];
+
+	for (int32 UsageIndex = WavePlan.FirstClassUsageIndex; UsageIndex < WavePlan.FirstClassUsageIndex + WavePlan.NumClassUsages; UsageIndex++)
+	{
+		const int32 EnemyClassIndex = WaveSchedule.ClassUsages[UsageIndex].EnemyClassIndex;
+
+		if (!LoadedEnemyClasses[EnemyClassIndex] && !FailedEnemyClasses[EnemyClassIndex])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32 UWarriorWaveStreamingSubsystem::GetNumLoadedEnemyClasses() const
+{
+	int32 NumLoadedEnemyClasses = 0;
+
+	for (const UClass* LoadedEnemyClass : LoadedEnemyClasses)
+	{
+		if (LoadedEnemyClass)
+		{
+			NumLoadedEnemyClasses++;
+		}
+	}
+
+	return NumLoadedEnemyClasses;
+}
+
+float UWarriorWaveStreamingSubsystem::GetRetainedMemoryMB() const
+{
+	int64 RetainedMemoryBytes = 0;
+
+	for (int32 EnemyClassIndex = 0; EnemyClassIndex < EnemyClassHandles.Num(); EnemyClassIndex++)
+	{
+		if (EnemyClassHandles[EnemyClassIndex].IsValid())
+		{
+			RetainedMemoryBytes += GetEstimatedClassMemoryBytes(EnemyClassIndex);
+		}
+	}
+
+	return static_cast<float>(RetainedMemoryBytes / (1024.0 * 1024.0));
+}
+
+void UWarriorWaveStreamingSubsystem::RequestEnemyClassLoad(int32 InEnemyClassIndex)
+{
+	if (EnemyClassHandles[InEnemyClassIndex].IsValid() || FailedEnemyClasses[InEnemyClassIndex])
+	{
+		return;
+	}
+
+	const TSoftClassPtr<AWarriorEnemyCharacter>& SoftEnemyClass = WaveSchedule.EnemyClasses[InEnemyClassIndex];
+
+	// 已经加载完成的资源会在 RequestAsyncLoad 内部直接回调，因此回调中不能依赖句柄已被赋值
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(SoftEnemyClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnEnemyClassLoaded, InEnemyClassIndex));
+
+	EnemyClassHandles[InEnemyClassIndex] = Handle;
+
+	// 路径无效时不会发起加载也不会回调，直接按加载失败处理
+	if (!Handle.IsValid())
+	{
+		OnEnemyClassLoaded(InEnemyClassIndex);
+	}
+}
+
+void UWarriorWaveStreamingSubsystem::ReleaseEnemyClass(int32 InEnemyClassIndex)
+{
+	TSharedPtr<FStreamableHandle>& Handle = EnemyClassHandles[InEnemyClassIndex];
+
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	// 休眠的池化敌人也会引用该类别，需要一并清理才能真正卸载
+	if (UWarriorEnemyPoolSubsystem* EnemyPoolSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UWarriorEnemyPoolSubsystem>() : nullptr)
+	{
+		EnemyPoolSubsystem->FlushDormantEnemies(WaveSchedule.EnemyClasses[InEnemyClassIndex]);
+	}
+
+	if (Handle->IsLoadingInProgress())
+	{
+		Handle->CancelHandle();
+	}
+	else
+	{
+		Handle->ReleaseHandle();
+	}
+
+	Handle.Reset();
+	LoadedEnemyClasses[InEnemyClassIndex] = nullptr;
+	FailedEnemyClasses[InEnemyClassIndex] = false;
+}
+
+void UWarriorWaveStreamingSubsystem::OnEnemyClassLoaded(int32 InEnemyClassIndex)
+{
+	UClass* LoadedEnemyClass = WaveSchedule.EnemyClasses[InEnemyClassIndex].Get();
+
+	if (LoadedEnemyClass)
+	{
+		LoadedEnemyClasses[InEnemyClassIndex] = LoadedEnemyClass;
+	}
+	else if (!FailedEnemyClasses[InEnemyClassIndex])
+	{
+		// 路径错误、资源缺失或加载失败，标记后波次不再等待该类别
+		UE_LOG(LogTemp, Error, TEXT("Failed to load enemy class %s, its wave spawns will be skipped"), *WaveSchedule.EnemyClasses[InEnemyClassIndex].ToString());
+
+		FailedEnemyClasses[InEnemyClassIndex] = true;
+	}
+
+	SET_DWORD_STAT(STAT_WarriorRetainedEnemyClasses, GetNumLoadedEnemyClasses());
+	SET_FLOAT_STAT(STAT_WarriorRetainedEnemyClassMemoryMB, GetRetainedMemoryMB());
+
+	const int32 LastWaveIndex = FMath::Min(CurrentWaveIndex + StreamingSettings.LookaheadWaves, WaveSchedule.GetNumWaves() - 1);
+
+	for (int32 WaveIndex = CurrentWaveIndex; WaveIndex <= LastWaveIndex; WaveIndex++)
+	{
+		const FWarriorCompiledWavePlan& WavePlan = WaveSchedule.WavePlans[WaveIndex];
+
+		bool bWaveUsesLoadedClass = false;
+
+		for (int32 UsageIndex = WavePlan.FirstClassUsageIndex; UsageIndex < WavePlan.FirstClassUsageIndex + WavePlan.NumClassUsages; UsageIndex++)
+		{
+			if (WaveSchedule.ClassUsages[UsageIndex].EnemyClassIndex == InEnemyClassIndex)
+			{
+				bWaveUsesLoadedClass = true;
+				break;
+			}
+		}
+
+		if (bWaveUsesLoadedClass && IsWaveReady(WaveIndex))
+		{
+			OnWaveAssetsReady.Broadcast(WaveIndex);
+		}
+	}
+}
+
+int64 UWarriorWaveStreamingSubsystem::GetEstimatedClassMemoryBytes(int32 InEnemyClassIndex) const
+{
+	const float* ConfiguredMemoryMB = StreamingSettings.EnemyClassMemoryMB.Find(WaveSchedule.EnemyClasses[InEnemyClassIndex]);
+	const float EnemyClassMemoryMB = ConfiguredMemoryMB ? *ConfiguredMemoryMB : StreamingSettings.EstimatedEnemyClassMemoryMB;
+
+	return static_cast<int64>(EnemyClassMemoryMB * 1024.f * 1024.f);
+}
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Widgets/WarriorEnemyHealthBarLayerWidget.h"
+
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Subsystems/WarriorEnemyRegistrySubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Gather Enemy Health Bars"), STAT_WarriorGatherEnemyHealthBars, STATGROUP_WarriorSurvival);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Visible Enemy Health Bars"), STAT_WarriorVisibleEnemyHealthBars, STATGROUP_WarriorSurvival);
+
+static TAutoConsoleVariable<bool> CVarWarriorBatchedEnemyHealthBars(
+	TEXT("warrior.BatchedEnemyHealthBars"),
+	true,
+	TEXT("Draw enemy health bars from a single layer added by the hero controller instead of a UWidgetComponent per enemy. Read when the level starts and when enemies spawn."),
+	ECVF_Default);
+
+bool UWarriorEnemyHealthBarLayerWidget::IsBatchedHealthBarEnabled()
+{
+	return CVarWarriorBatchedEnemyHealthBars.GetValueOnGameThread();
+}
+
+void UWarriorEnemyHealthBarLayerWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorGatherEnemyHealthBars);
+
+	HealthBarDrawElements.Reset();
+
+	const APlayerController* OwningPlayerController = GetOwningPlayer();
+	const UWarriorEnemyRegistrySubsystem* EnemyRegistrySubsystem = GetWorld() ? GetWorld()->GetSubsystem<UWarriorEnemyRegistrySubsystem>() : nullptr;
+
+	if (!IsBatchedHealthBarEnabled() || !OwningPlayerController || !OwningPlayerController->PlayerCameraManager || !EnemyRegistrySubsystem)
+	{
+		SET_DWORD_STAT(STAT_WarriorVisibleEnemyHealthBars, 0);
+		return;
+	}
+
+	const FVector CameraLocation = OwningPlayerController->PlayerCameraManager->GetCameraLocation();
+	const float MaxDrawDistanceSquared = FMath::Square(MaxDrawDistance);
+
+	// 本控件铺满视口，屏幕坐标除以视口缩放即为局部坐标
+	const float ViewportScale = FMath::Max(UWidgetLayoutLibrary::GetViewportScale(this), KINDA_SMALL_NUMBER);
+	const FVector2D ViewportSize = UWidgetLayoutLibrary::GetViewportSize(this);
+
+	const TArray<AWarriorEnemyCharacter*>& RegisteredEnemies = EnemyRegistrySubsystem->GetRegisteredEnemies();
+	const TArray<FVector>& EnemyLocations = EnemyRegistrySubsystem->GetEnemyLocations();
+
+	for (int32 RegistryIndex = 0; RegistryIndex < RegisteredEnemies.Num(); RegistryIndex++)
+	{
+		const AWarriorEnemyCharacter* Enemy = RegisteredEnemies[RegistryIndex];
+
+		if (EnemyRegistrySubsystem->IsEnemyDeadAt(RegistryIndex) || !IsValid(Enemy) || Enemy->IsHidden())
+		{
+			continue;
+		}
+
+		const FVector BarWorldLocation = EnemyLocations[RegistryIndex] + FVector(0.f, 0.f, BarWorldHeightOffset);
+
+		if (FVector::DistSquared(BarWorldLocation, CameraLocation) > MaxDrawDistanceSquared)
+		{
+			continue;
+		}
+
+		const float HealthPercent = Enemy->GetEnemyUIComponent()->GetCachedHealthPercent();
+
+		if (bOnlyDrawDamagedEnemies && HealthPercent >= 1.f)
+		{
+			continue;
+		}
+
+		FVector2D ScreenPosition;
+
+		if (!OwningPlayerController->ProjectWorldLocationToScreen(BarWorldLocation, ScreenPosition, true))
+		{
+			continue;
+		}
+
+		// 血条完全位于视口之外时剔除
+		if (ScreenPosition.X < -BarSize.X * ViewportScale || ScreenPosition.X > ViewportSize.X + BarSize.X * ViewportScale
+			|| ScreenPosition.Y < -BarSize.Y * ViewportScale || ScreenPosition.Y > ViewportSize.Y + BarSize.Y * ViewportScale)
+		{
+			continue;
+		}
+
+		FWarriorHealthBarDrawElement& DrawElement = HealthBarDrawElements.AddDefaulted_GetRef();
+		DrawElement.LocalPosition = ScreenPosition / ViewportScale;
+		DrawElement.HealthPercent = FMath::Clamp(HealthPercent, 0.f, 1.f);
+	}
+
+	SET_DWORD_STAT(STAT_WarriorVisibleEnemyHealthBars, HealthBarDrawElements.Num());
+}
+
+int32 UWarriorEnemyHealthBarLayerWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+	const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
+	bool bParentEnabled) const
+{
+	const int32 MaxLayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	if (HealthBarDrawElements.IsEmpty())
+	{
+		return MaxLayerId;
+	}
+
+	const int32 BackgroundLayerId = MaxLayerId + 1;
+	const int32 FillLayerId = MaxLayerId + 2;
+	const FVector2D HalfBarSize = BarSize * 0.5f;
+
+	for (const FWarriorHealthBarDrawElement& DrawElement : HealthBarDrawElements)
+	{
+		const FVector2D BarTopLeft = DrawElement.LocalPosition - HalfBarSize;
+
+		FSlateDrawElement::MakeBox(OutDrawElements, BackgroundLayerId,
+			AllottedGeometry.ToPaintGeometry(BarSize, FSlateLayoutTransform(BarTopLeft)),
+			&BackgroundBrush, ESlateDrawEffect::None, BackgroundColor * InWidgetStyle.GetColorAndOpacityTint());
+
+		FSlateDrawElement::MakeBox(OutDrawElements, FillLayerId,
+			AllottedGeometry.ToPaintGeometry(FVector2D(BarSize.X * DrawElement.HealthPercent, BarSize.Y), FSlateLayoutTransform(BarTopLeft)),
+			&FillBrush, ESlateDrawEffect::None, FillColor * InWidgetStyle.GetColorAndOpacityTint());
+	}
+
+	return FillLayerId;
+}
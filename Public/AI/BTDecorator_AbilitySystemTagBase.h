@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTDecorator.h"
+#include "GameplayTagContainer.h"
+#include "BTDecorator_AbilitySystemTagBase.generated.h"
+
+class UAbilitySystemComponent;
+
+
+struct FAbilitySystemTagDecoratorMemory
+{
+	TWeakObjectPtr<UAbilitySystemComponent> ObservedASC;
+
+	TArray<TPair<FGameplayTag, FDelegateHandle>> TagEventHandles;
+};
+
+
+/**
+ * 原生的能力系统标签条件装饰器基类，直接读取 ASC 上的标签计数，取代在蓝图虚拟机中每次求值的蓝图装饰器
+ * 观察模式不为 None 时，节点生效期间通过 RegisterGameplayTagEvent 监听相关标签的添加与移除
+ * 只有标签真正变化且条件结果随之改变时才请求行为树重新执行，不需要每帧重新求值
+ */
+UCLASS(Abstract)
+class WARRIOR_API UBTDecorator_AbilitySystemTagBase : public UBTDecorator
+{
+	GENERATED_BODY()
+
+protected:
+	UBTDecorator_AbilitySystemTagBase();
+
+	// ~ Begin UBTNode Interface
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	// ~ End UBTNode Interface
+
+	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	// 需要监听变化的标签，子类按各自的条件填充
+	virtual void GetObservedTags(TArray<FGameplayTag>& OutTags) const PURE_VIRTUAL(UBTDecorator_AbilitySystemTagBase::GetObservedTags, );
+
+	// 按 ASC 当前拥有的标签计算条件
+	virtual bool EvaluateTags(const UAbilitySystemComponent& InASC) const PURE_VIRTUAL(UBTDecorator_AbilitySystemTagBase::EvaluateTags, return false;);
+
+	// 条件描述中显示的检查对象
+	FString GetActorDescription() const;
+
+	// 要检查的 Actor，未指定时检查被控制的 Pawn
+	UPROPERTY(EditAnywhere, Category = "Gameplay Tag")
+	FBlackboardKeySelector ActorToCheck;
+
+private:
+	UAbilitySystemComponent* GetAbilitySystemComponentToCheck(const UBehaviorTreeComponent& OwnerComp) const;
+
+	void RegisterTagEvents(UBehaviorTreeComponent& OwnerComp, FAbilitySystemTagDecoratorMemory* Memory) const;
+	void UnregisterTagEvents(FAbilitySystemTagDecoratorMemory* Memory) const;
+
+	void OnObservedTagChanged(const FGameplayTag InTag, int32 InNewCount, TWeakObjectPtr<UBehaviorTreeComponent> InOwnerComp) const;
+
+	// 检查对象换人时改为监听新对象的 ASC
+	EBlackboardNotificationResult OnActorToCheckChanged(const UBlackboardComponent& InBlackboard, FBlackboard::FKey InChangedKeyID);
+
+	bool ShouldObserveActorToCheck() const;
+};
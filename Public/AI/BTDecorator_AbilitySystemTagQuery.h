@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/BTDecorator_AbilitySystemTagBase.h"
+#include "BTDecorator_AbilitySystemTagQuery.generated.h"
+
+
+/**
+ * 用可配置的标签查询检查 ASC 拥有的标签，例如"未死亡且处于不可格挡状态"
+ * 监听查询中出现的所有标签，任意一个变化时重新匹配
+ */
+UCLASS()
+class WARRIOR_API UBTDecorator_AbilitySystemTagQuery : public UBTDecorator_AbilitySystemTagBase
+{
+	GENERATED_BODY()
+
+	UBTDecorator_AbilitySystemTagQuery();
+
+	// ~ Begin UBTNode Interface
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual FString GetStaticDescription() const override;
+	// ~ End UBTNode Interface
+
+	// ~ Begin UBTDecorator_AbilitySystemTagBase Interface
+	virtual void GetObservedTags(TArray<FGameplayTag>& OutTags) const override;
+	virtual bool EvaluateTags(const UAbilitySystemComponent& InASC) const override;
+	// ~ End UBTDecorator_AbilitySystemTagBase Interface
+
+	UPROPERTY(EditAnywhere, Category = "Gameplay Tag")
+	FGameplayTagQuery TagQuery;
+
+	// 查询中出现的标签，资源加载时收集一次
+	TArray<FGameplayTag> QueryTags;
+	
+	
+};
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTDecorator.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
+#include "BTDecorator_AttackToken.generated.h"
+
+
+struct FAttackTokenDecoratorMemory
+{
+	// 分支执行期间为 true
+	bool bIsRelevant {false};
+
+	bool bHoldsToken {false};
+};
+
+
+/**
+ * 向 UWarriorAttackTokenSubsystem 申请攻击名额，拿到名额时才进入分支，分支结束时归还
+ * 放在激活攻击能力的分支上，没拿到名额的敌人会继续执行其他分支（例如绕圈）
+ * 条件检查只读取名额状态，进入分支时才真正申请；同一帧被别的敌人抢先时打断自身分支
+ * 不支持反转条件，勾选 Inverse Condition 会被忽略
+ */
+UCLASS()
+class WARRIOR_API UBTDecorator_AttackToken : public UBTDecorator
+{
+	GENERATED_BODY()
+
+	UBTDecorator_AttackToken();
+
+	// ~ Begin UBTNode Interface
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+	// ~ End UBTNode Interface
+
+	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	UPROPERTY(EditAnywhere, Category = "Attack Token")
+	EWarriorAttackTokenType TokenType;
+	
+	
+};
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/BTDecorator_AbilitySystemTagBase.h"
+#include "BTDecorator_HasAbilitySystemTag.generated.h"
+
+
+/**
+ * 检查 ASC 上是否拥有单个标签（含子标签），例如 Shared.Status.Dead、Enemy.Status.UnderAttack
+ * 直接读取标签计数，是最常见也最便宜的一种检查
+ */
+UCLASS()
+class WARRIOR_API UBTDecorator_HasAbilitySystemTag : public UBTDecorator_AbilitySystemTagBase
+{
+	GENERATED_BODY()
+
+	UBTDecorator_HasAbilitySystemTag();
+
+	// ~ Begin UBTNode Interface
+	virtual FString GetStaticDescription() const override;
+	// ~ End UBTNode Interface
+
+	// ~ Begin UBTDecorator_AbilitySystemTagBase Interface
+	virtual void GetObservedTags(TArray<FGameplayTag>& OutTags) const override;
+	virtual bool EvaluateTags(const UAbilitySystemComponent& InASC) const override;
+	// ~ End UBTDecorator_AbilitySystemTagBase Interface
+
+	UPROPERTY(EditAnywhere, Category = "Gameplay Tag")
+	FGameplayTag TagToCheck;
+	
+	
+};
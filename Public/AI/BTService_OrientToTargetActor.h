@@ -6,8 +6,16 @@
 #include "BehaviorTree/BTService.h"
 #include "BTService_OrientToTargetActor.generated.h"
 
+
+struct FOrientToTargetActorServiceMemory
+{
+	uint32 OrientRequestId;
+};
+
+
 /**
- * 
+ * 节点生效期间向 UWarriorOrientationSubsystem 登记一个持续转向请求，转向由子系统每帧统一完成
+ * 服务本身只按 Interval 检查黑板中的目标是否变化
  */
 UCLASS()
 class WARRIOR_API UBTService_OrientToTargetActor : public UBTService
@@ -18,11 +26,17 @@ class WARRIOR_API UBTService_OrientToTargetActor : public UBTService
 
 	// ~Begin UBTNode Interface
 	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override;
 	virtual FString GetStaticDescription() const override;
 	// ~End UBTNode Interface
 
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 
+	// 按黑板中的当前目标登记或更新转向请求，目标为空时移除请求
+	void RefreshOrientRequest(UBehaviorTreeComponent& OwnerComp, FOrientToTargetActorServiceMemory* Memory) const;
+
 	UPROPERTY(EditAnywhere, Category = "Target")
 	FBlackboardKeySelector InTargetActorKey;
 
@@ -12,6 +12,9 @@ struct FRotateToFaceTargetTaskMemory
 	TWeakObjectPtr<APawn> OwningPawn;
 	TWeakObjectPtr<AActor> TargetActor;
 
+	// 在 UWarriorOrientationSubsystem 中登记的转向请求，0表示没有请求
+	uint32 OrientRequestId;
+
 	bool IsValid() const
 	{
 		return OwningPawn.IsValid() && TargetActor.IsValid();
@@ -21,12 +24,13 @@ struct FRotateToFaceTargetTaskMemory
 	{
 		OwningPawn.Reset();
 		TargetActor.Reset();
+		OrientRequestId = 0;
 	}
 };
 
 
 /**
- * 
+ * 向 UWarriorOrientationSubsystem 登记带角度精度的转向请求，子系统在朝向目标后回调结束任务
  */
 UCLASS()
 class WARRIOR_API UBTTask_RotateToFaceTarget : public UBTTaskNode
@@ -42,9 +46,11 @@ class WARRIOR_API UBTTask_RotateToFaceTarget : public UBTTaskNode
 	// ~ End UBTNode Interface
 
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
-	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
 
-	bool HasReachedAnglePrecision(APawn* QueryPawn, AActor* TargetActor) const;
+	// 移除尚未结束的转向请求
+	void RemoveOrientRequest(UBehaviorTreeComponent& OwnerComp, FRotateToFaceTargetTaskMemory* Memory) const;
 
 	UPROPERTY(EditAnywhere, Category = "Face Target")
 	float AnglePrecision;
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeConditionBase.h"
+#include "STCondition_HasTarget.generated.h"
+
+class AWarriorAIController;
+
+USTRUCT()
+struct FSTCondition_HasTargetInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Context")
+	AWarriorAIController* AIController = nullptr;
+};
+
+/**
+ * 控制器是否已经获得目标
+ */
+USTRUCT(meta = (DisplayName = "Native Has Target", Category = "Warrior"))
+struct WARRIOR_API FSTCondition_HasTarget : public FStateTreeConditionCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FSTCondition_HasTargetInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override
+	{
+		return FInstanceDataType::StaticStruct();
+	}
+
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	bool bInvert = false;
+};
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeConditionBase.h"
+#include "STCondition_TargetInRange.generated.h"
+
+class AWarriorAIController;
+
+USTRUCT()
+struct FSTCondition_TargetInRangeInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Context")
+	AWarriorAIController* AIController = nullptr;
+
+	UPROPERTY(EditAnywhere, Category = "Input")
+	AActor* TargetActor = nullptr;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	float MinDistance = 0.f;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	float MaxDistance = 200.f;
+};
+
+/**
+ * 目标与自身的距离是否在 [MinDistance, MaxDistance] 之内，用于在近战、远程与横移之间选择
+ */
+USTRUCT(meta = (DisplayName = "Native Target In Range", Category = "Warrior"))
+struct WARRIOR_API FSTCondition_TargetInRange : public FStateTreeConditionCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FSTCondition_TargetInRangeInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override
+	{
+		return FInstanceDataType::StaticStruct();
+	}
+
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	bool bInvert = false;
+};
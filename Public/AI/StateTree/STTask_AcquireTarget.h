@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeTaskBase.h"
+#include "STTask_AcquireTarget.generated.h"
+
+class AWarriorAIController;
+
+USTRUCT()
+struct FSTTask_AcquireTargetInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Context")
+	AWarriorAIController* AIController = nullptr;
+
+	UPROPERTY(VisibleAnywhere, Category = "Output")
+	AActor* TargetActor = nullptr;
+};
+
+/**
+ * 等待控制器获得目标（由共享目标定位或视觉感知写入），获得后输出目标并成功结束
+ */
+USTRUCT(meta = (DisplayName = "Native Acquire Target", Category = "Warrior"))
+struct WARRIOR_API FSTTask_AcquireTarget : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FSTTask_AcquireTargetInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override
+	{
+		return FInstanceDataType::StaticStruct();
+	}
+
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+
+private:
+	EStateTreeRunStatus PollTarget(FStateTreeExecutionContext& Context) const;
+};
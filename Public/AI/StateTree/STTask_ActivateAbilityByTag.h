@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "StateTreeTaskBase.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
+#include "STTask_ActivateAbilityByTag.generated.h"
+
+class AWarriorAIController;
+
+USTRUCT()
+struct FSTTask_ActivateAbilityByTagInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Context")
+	AWarriorAIController* AIController = nullptr;
+
+	bool bHoldsAttackToken = false;
+};
+
+/**
+ * 按标签随机激活一个能力（例如 Enemy_Ability_Melee / Enemy_Ability_Ranged），能力结束后成功结束
+ * 可选地先向 UWarriorAttackTokenSubsystem 申请攻击名额，拿不到名额时失败，离开状态时归还
+ */
+USTRUCT(meta = (DisplayName = "Native Activate Ability By Tag", Category = "Warrior"))
+struct WARRIOR_API FSTTask_ActivateAbilityByTag : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FSTTask_ActivateAbilityByTagInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override
+	{
+		return FInstanceDataType::StaticStruct();
+	}
+
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter", meta = (Categories = "Enemy.Ability"))
+	FGameplayTag AbilityTag;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	bool bRequireAttackToken = true;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter", meta = (EditCondition = "bRequireAttackToken"))
+	EWarriorAttackTokenType AttackTokenType = EWarriorAttackTokenType::Melee;
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeTaskBase.h"
+#include "STTask_FaceTarget.generated.h"
+
+class AWarriorAIController;
+
+USTRUCT()
+struct FSTTask_FaceTargetInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Context")
+	AWarriorAIController* AIController = nullptr;
+
+	UPROPERTY(EditAnywhere, Category = "Input")
+	AActor* TargetActor = nullptr;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	float AnglePrecision = 10.f;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	float RotationInterpSpeed = 5.f;
+
+	// 为 false 时持续朝向目标直到离开状态，与 BTService_OrientToTargetActor 相同
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	bool bFinishWhenFacing = true;
+
+	uint32 OrientRequestId = 0;
+};
+
+/**
+ * 通过 UWarriorOrientationSubsystem 转向目标，与 BTTask_RotateToFaceTarget 相同，任务本身不做插值
+ */
+USTRUCT(meta = (DisplayName = "Native Face Target", Category = "Warrior"))
+struct WARRIOR_API FSTTask_FaceTarget : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FSTTask_FaceTargetInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override
+	{
+		return FInstanceDataType::StaticStruct();
+	}
+
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+};
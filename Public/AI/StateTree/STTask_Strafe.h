@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeTaskBase.h"
+#include "STTask_Strafe.generated.h"
+
+class AWarriorAIController;
+
+USTRUCT()
+struct FSTTask_StrafeInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Context")
+	AWarriorAIController* AIController = nullptr;
+
+	UPROPERTY(EditAnywhere, Category = "Input")
+	AActor* TargetActor = nullptr;
+
+	// 在自身周围该半径内随机选取可到达的点
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	float StrafeRadius = 400.f;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	float StrafeWalkSpeed = 200.f;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	float AcceptanceRadius = 50.f;
+
+	UPROPERTY(EditAnywhere, Category = "Parameter")
+	float RotationInterpSpeed = 5.f;
+
+	float PreviousMaxWalkSpeed = 0.f;
+
+	uint32 OrientRequestId = 0;
+};
+
+/**
+ * 带 Enemy_Status_Strafing 标签、以较低速度移动到附近的随机点，移动期间始终朝向目标
+ * 到达后成功结束，离开状态时恢复移动速度并移除标签
+ */
+USTRUCT(meta = (DisplayName = "Native Strafe Around Target", Category = "Warrior"))
+struct WARRIOR_API FSTTask_Strafe : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FSTTask_StrafeInstanceData;
+
+	virtual const UStruct* GetInstanceDataType() const override
+	{
+		return FInstanceDataType::StaticStruct();
+	}
+
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+};
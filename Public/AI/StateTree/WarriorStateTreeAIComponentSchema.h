@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/StateTreeAIComponentSchema.h"
+#include "WarriorStateTreeAIComponentSchema.generated.h"
+
+/**
+ * @brief 敌人状态树的结构定义
+ *
+ * 上下文中的 Actor 固定为 AWarriorEnemyCharacter，AIController 固定为 AWarriorAIController
+ * STTask_ 与 STCondition_ 开头的任务和条件会自动绑定到这两个上下文对象
+ */
+UCLASS(BlueprintType, EditInlineNew, CollapseCategories, meta = (DisplayName = "Warrior Enemy StateTree"))
+class WARRIOR_API UWarriorStateTreeAIComponentSchema : public UStateTreeAIComponentSchema
+{
+	GENERATED_BODY()
+
+public:
+	UWarriorStateTreeAIComponentSchema(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Navigation/CrowdManager.h"
+#include "WarriorCrowdManager.generated.h"
+
+/**
+ * @brief 记录每帧群体模拟耗时的 UCrowdManager
+ *
+ * 在 DefaultEngine.ini 的 [/Script/NavigationSystem.NavigationSystemV1] 中设置
+ * CrowdManagerClass=/Script/Warrior.WarriorCrowdManager 后生效
+ * 耗时与参与模拟的代理数量在 stat WarriorSurvival 中显示
+ */
+UCLASS()
+class WARRIOR_API UWarriorCrowdManager : public UCrowdManager
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UCrowdManagerBase Interface.
+	virtual void Tick(float DeltaTime) override;
+	//~ End UCrowdManagerBase Interface.
+
+	// 上一帧群体模拟的耗时（毫秒）
+	FORCEINLINE float GetLastSimulationTimeMs() const
+	{
+		return LastSimulationTimeMs;
+	}
+
+	FORCEINLINE int32 GetNumCrowdAgents() const
+	{
+		return ActiveAgents.Num();
+	}
+
+private:
+	float LastSimulationTimeMs {0.f};
+};
@@ -48,9 +48,6 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
 	FVector TraceBoxSize = FVector(5000.f, 5000.f, 300.f);
 
-	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
-	TArray < TEnumAsByte < EObjectTypeQuery > > BoxTraceChannel;
-
 	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
 	bool bShowPersistentDebugShape { false };
 
@@ -10,7 +10,10 @@
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FWaitSpawnEnemiesDelegate, const TArray<AWarriorEnemyCharacter*>&, SpawnedEnemies);
 
 /**
- * 
+ * @brief 等待游戏事件并召唤敌人
+ *
+ * 任务激活时即通过对象池加载敌人类别并排队预热休眠实例，收到事件后把召唤请求交给对象池按每帧预算处理
+ * 最后一个敌人生成完成后才广播 OnSpawnFinished
  */
 UCLASS()
 class WARRIOR_API UAbilityTask_WaitSpawnEnemies : public UAbilityTask
@@ -45,6 +48,21 @@ private:
 	// FRotator CachedSpawnRotation;     不需要这个变量 使用这个变量会导致BOSS的朝向无法改变
 	FDelegateHandle DelegateHandle;
 
+	UPROPERTY()
+	UClass* CachedLoadedEnemyClass;
+
+	UPROPERTY()
+	TArray<AWarriorEnemyCharacter*> SummonedEnemies;
+
+	int32 NumPendingSummons {0};
+
+	bool bEnemyClassLoadFinished {false};
+
+	bool bSpawnRequested {false};
+
 	void OnGameplayEventReceived(const FGameplayEventData* InPayload);
 	void OnEnemyClassLoaded();
+	void EnqueueEnemySummons();
+	void OnEnemySummoned(AWarriorEnemyCharacter* InSummonedEnemy);
+	void FinishSpawnEnemies();
 };
@@ -56,5 +56,12 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Warrior|Ability")
 	bool TryActivateAbilityByTag(FGameplayTag AbilityTagToActivate);
+
+	/**
+	 * 将能力系统组件恢复到刚生成时的状态，供对象池复用角色时调用
+	 * 
+	 * 取消并清除所有能力，移除所有激活中的效果与临时标签
+	 */
+	void ResetAbilitySystemForReuse();
 	
 };
\ No newline at end of file
@@ -41,6 +41,9 @@ public:
 
 	virtual void PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data) override;
 
+	// 将所有属性恢复为类默认值，供对象池复用角色时调用，随后由启动数据重新初始化
+	void ResetAttributesToDefaults();
+
 	// 当前生命值
 	UPROPERTY(BlueprintReadOnly, Category = "Health")
 	FGameplayAttributeData CurrentHealth;
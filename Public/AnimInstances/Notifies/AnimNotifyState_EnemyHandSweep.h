@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "Components/Combat/PawnCombatComponent.h"
+#include "AnimNotifyState_EnemyHandSweep.generated.h"
+
+/**
+ * @brief 敌人徒手攻击判定窗口
+ *
+ * 放在攻击蒙太奇上，窗口开始时开启指定手部的扫掠判定，结束时关闭
+ * 扫掠本身由 UEnemyCombatComponent 在每帧动画更新之后完成
+ */
+UCLASS(meta = (DisplayName = "Enemy Hand Sweep"))
+class WARRIOR_API UAnimNotifyState_EnemyHandSweep : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UAnimNotifyState Interface.
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration,
+		const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
+		const FAnimNotifyEventReference& EventReference) override;
+	virtual FString GetNotifyName_Implementation() const override;
+	//~ End UAnimNotifyState Interface.
+
+protected:
+	// 需要判定的手部，只能是左手或右手
+	UPROPERTY(EditAnywhere, Category = "Hand Sweep", meta = (InvalidEnumValues = "CurrentEquippedWeapon"))
+	EToggleDamageType HandToSweep {EToggleDamageType::RightHand};
+};
@@ -50,8 +50,10 @@ public:
 	 * 1. 禁用角色的Tick功能以提高性能
 	 * 2. 创建并初始化能力系统组件
 	 * 3. 创建并初始化属性集组件
+	 *
+	 * @param ObjectInitializer 子类可以通过它替换默认组件的类型，例如敌人使用受动画预算管理的网格体
 	 */
-	AWarriorBaseCharacter();
+	AWarriorBaseCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	//~ Begin IAbilitySystemInterface Interface.
 	/**
@@ -7,8 +7,14 @@
 #include "Components/WidgetComponent.h"
 #include "Components/Combat/EnemyCombatComponent.h"
 #include "Components/UI/EnemyUIComponent.h"
+#include "GameModes/WarriorBaseGameMode.h"
 #include "WarriorEnemyCharacter.generated.h"
 
+class AAIController;
+class UStateTree;
+class UStaticMesh;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyDeathFinishedDelegate, AActor*, FinishedEnemy);
 
 /**
  * @brief 敌人角色类
@@ -35,8 +41,9 @@ public:
 	 * 设置敌人角色的默认属性值
 	 * 配置AI控制和移动相关参数
 	 * 初始化敌人战斗组件
+	 * 网格体替换为 UWarriorBudgetedSkeletalMeshComponent，以便接入动画预算分配器
 	 */
-	AWarriorEnemyCharacter();
+	AWarriorEnemyCharacter(const FObjectInitializer& ObjectInitializer);
 
 	//~ Begin IPawnCombatInterface Interface.
 	/**
@@ -57,9 +64,60 @@ public:
 	virtual UEnemyUIComponent* GetEnemyUIComponent() const override;
 	//~ End IPawnUIInterface Interface.
 
+	/**
+	 * @brief 结束死亡流程
+	 *
+	 * 死亡能力播放完毕后调用，替代直接销毁Actor
+	 * 若该敌人由对象池管理则回收进池，否则销毁
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Warrior|Enemy")
+	void FinishDeath();
+
+	// 从对象池取出时调用：重置状态、放置到新位置并重新被AI控制器占有
+	void OnAcquiredFromPool(const FVector& InLocation, const FRotator& InRotation);
+
+	// 回收进对象池时调用：停止AI、清空能力与效果、隐藏并关闭碰撞
+	void OnReleasedToPool();
+
+	// 按重要度级别设置移动、动画、行为树、感知与血条的更新频率，级别未变化时不做任何事
+	void ApplySignificanceTier(EWarriorEnemySignificanceTier InTier, const FWarriorSignificanceTierSettings& InTierSettings);
+
+	// 丢弃当前级别，下一次分级时重新应用各组件的更新频率
+	void InvalidateSignificanceTier();
+
+	// 由群体实体提升而来时保留原有的血量，启动数据尚未应用时等应用完成后再生效
+	void SetPendingHealthPercent(float InHealthPercent);
+
+	/**
+	 * @brief 进入休眠
+	 *
+	 * 由 UWarriorEnemyDormancySubsystem 对远离玩家的敌人调用
+	 * 暂停行为树与感知，停止移动组件更新，动画只在被渲染时更新，并冻结头顶血条
+	 */
+	void EnterDormancy();
+
+	// 从休眠中唤醒，除距离与受击外也可以由关卡事件等显式调用，未休眠时不做任何事
+	UFUNCTION(BlueprintCallable, Category = "Warrior|Enemy")
+	void WakeFromDormancy();
+
+	// 死亡流程结束（回收或销毁）时广播，每次生命周期只广播一次
+	// 绑定在对象池复用后依然保留，只关心单次生命周期的监听者应在回调中自行解绑
+	UPROPERTY(BlueprintAssignable)
+	FOnEnemyDeathFinishedDelegate OnEnemyDeathFinished;
+
 protected:
 
 	virtual void BeginPlay() override;
+
+	//~ Begin AActor Interface.
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Destroyed() override;
+	//~ End AActor Interface.
+
+	// 从对象池取出后调用，供蓝图重置溶解材质等表现层状态
+	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "On Acquired From Pool"))
+	void BP_OnAcquiredFromPool();
 	
 	
 	/**
@@ -78,11 +136,6 @@ protected:
 	virtual void PossessedBy(AController* NewController) override;
 	//~ End APawn Interface.
 
-#if WITH_EDITOR
-	//~ Begin UObject Interface.
-	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
-	//~ End UObject Interface.
-#endif
 	
 	
 	/**
@@ -94,15 +147,11 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
 	UEnemyCombatComponent* EnemyCombatComponent;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
-	UBoxComponent* LeftHandCollisionBox;
-
+	// 左手攻击判定扫掠所跟随的骨骼
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
 	FName LeftHandCollisionAttachmentBoneName;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
-	UBoxComponent* RightHandCollisionBox;
-
+	// 右手攻击判定扫掠所跟随的骨骼
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
 	FName RightHandCollisionAttachmentBoneName;
 
@@ -111,9 +160,18 @@ protected:
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
 	UWidgetComponent* EnemyHealthWidgetComponent;
-	
-	UFUNCTION()
-	virtual void OnBodyCollisionBoxBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult);
+
+	// 为 StateTree 且设置了 StateTreeBrain 时由控制器运行状态树，不再运行蓝图中指定的行为树
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
+	EWarriorEnemyBrainType EnemyBrainType {EWarriorEnemyBrainType::BehaviorTree};
+
+	// 使用 UWarriorStateTreeAIComponentSchema 的状态树资产
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
+	UStateTree* StateTreeBrain;
+
+	// 作为远处的群体实体时使用的实例化静态网格体，原点应位于脚底，为空时群体实体不显示
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crowd")
+	UStaticMesh* CrowdProxyMesh;
 
 private:
 	/**
@@ -129,6 +187,43 @@ private:
 	 */
 	void InitEnemyStartUpData();
 
+	// 把启动数据应用到能力系统组件，并记录从占有到就绪的耗时
+	void ApplyEnemyStartUpData(int32 AbilityApplyLevel);
+
+	void BroadcastDeathFinished();
+
+	void ApplyPendingHealthPercent();
+
+	// 受击事件唤醒休眠的敌人
+	void OnHitReactEventReceived(const FGameplayEventData* InPayload);
+
+	// 回收进对象池时保留的AI控制器，取出时重新占有，避免重复生成控制器
+	UPROPERTY()
+	AAIController* PooledAIController;
+
+	bool bHasBroadcastDeathFinished {false};
+
+	// 最近一次被占有的时间，用于统计从占有到就绪的耗时
+	double PossessedTimeSeconds {0.0};
+
+	EWarriorEnemySignificanceTier CurrentSignificanceTier {EWarriorEnemySignificanceTier::MAX};
+
+	bool bIsDormant {false};
+
+	// 启动数据应用完成后要恢复到的血量百分比
+	float PendingHealthPercent {1.f};
+
+	// 本次占有的启动数据是否已经应用
+	bool bHasAppliedStartUpData {false};
+
+	// 最近一次醒来（或从对象池取出）的世界时间
+	float LastWakeTime {0.f};
+
+	// 在存活敌人登记表中的下标，未登记时为 INDEX_NONE，只由登记表维护
+	int32 EnemyRegistryIndex {INDEX_NONE};
+
+	friend class UWarriorEnemyRegistrySubsystem;
+
 	
 public:
 	/**
@@ -143,14 +238,42 @@ public:
 		return EnemyCombatComponent;
 	}
 
-	FORCEINLINE UBoxComponent* GetLeftHandCollisionBox() const
+	// 获取指定手部攻击判定所跟随的骨骼，非手部类型返回 NAME_None
+	FName GetHandSweepBoneName(EToggleDamageType InHandType) const;
+
+	FORCEINLINE EWarriorEnemySignificanceTier GetCurrentSignificanceTier() const
+	{
+		return CurrentSignificanceTier;
+	}
+
+	FORCEINLINE bool IsDormant() const
+	{
+		return bIsDormant;
+	}
+
+	FORCEINLINE float GetLastWakeTime() const
+	{
+		return LastWakeTime;
+	}
+
+	FORCEINLINE EWarriorEnemyBrainType GetEnemyBrainType() const
+	{
+		return EnemyBrainType;
+	}
+
+	FORCEINLINE UStateTree* GetStateTreeBrain() const
+	{
+		return StateTreeBrain;
+	}
+
+	FORCEINLINE UStaticMesh* GetCrowdProxyMesh() const
 	{
-		return LeftHandCollisionBox;
+		return CrowdProxyMesh;
 	}
 
-	FORCEINLINE UBoxComponent* GetRightHandCollisionBox() const
+	FORCEINLINE int32 GetEnemyRegistryIndex() const
 	{
-		return RightHandCollisionBox;
+		return EnemyRegistryIndex;
 	}
 
 	
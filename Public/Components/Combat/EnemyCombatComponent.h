@@ -7,7 +7,11 @@
 #include "EnemyCombatComponent.generated.h"
 
 /**
- * 
+ * @brief 敌人战斗组件
+ *
+ * 徒手攻击不再依赖挂在手上的碰撞盒，而是在攻击判定窗口内逐帧扫掠手部骨骼
+ * 窗口由 UAnimNotifyState_EnemyHandSweep 或 ToggleWeaponCollision(LeftHand/RightHand) 开启与关闭
+ * 每帧把上一帧与当前帧的手部变换按子步插值后做球体扫掠，挥击过快时也不会穿过目标，命中统一交给 OnHitTargetActor 处理
  */
 UCLASS()
 class WARRIOR_API UEnemyCombatComponent : public UPawnCombatComponent
@@ -15,9 +19,51 @@ class WARRIOR_API UEnemyCombatComponent : public UPawnCombatComponent
 	GENERATED_BODY()
 
 public:
+	UEnemyCombatComponent();
+
+	//~ Begin UActorComponent Interface.
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface.
+
 	virtual void OnHitTargetActor(AActor* HitActor) override;
+	virtual void ResetCombatState() override;
 
 protected:
 	virtual void ToggleBodyCollisionBoxCollision(bool bShouldEnable, EToggleDamageType ToggleDamageType) override;
-	
+
+	// 手部扫掠球体的半径
+	UPROPERTY(EditDefaultsOnly, Category = "Combat|Hand Sweep")
+	float HandSweepRadius {20.f};
+
+	// 单个子步允许手部移动的最大距离，移动更远时细分为更多子步
+	UPROPERTY(EditDefaultsOnly, Category = "Combat|Hand Sweep")
+	float MaxHandSweepSubStepDistance {15.f};
+
+	// 每帧每只手最多的子步数量
+	UPROPERTY(EditDefaultsOnly, Category = "Combat|Hand Sweep")
+	int32 MaxHandSweepSubSteps {8};
+
+	UPROPERTY(EditDefaultsOnly, Category = "Combat|Hand Sweep")
+	bool bDrawDebugHandSweep {false};
+
+private:
+	// 一只手正在进行的攻击判定窗口，骨骼变换保存在网格体组件空间中
+	struct FActiveHandSweep
+	{
+		EToggleDamageType HandType;
+		FName BoneName;
+		FTransform PreviousBoneComponentTransform;
+		FTransform PreviousComponentToWorld;
+	};
+
+	void SweepActiveHands();
+
+	// 在两帧之间插值出手部骨骼的世界位置，角色自身的转身也会体现为弧线
+	static FVector InterpolateHandLocation(const FActiveHandSweep& InHandSweep, const FTransform& InBoneComponentTransform,
+		const FTransform& InComponentToWorld, float InAlpha);
+
+	TArray<FActiveHandSweep, TInlineAllocator<2>> ActiveHandSweeps;
+
+	// 复用的扫掠结果数组，避免每帧分配内存
+	TArray<FHitResult> HandSweepHitResults;
 };
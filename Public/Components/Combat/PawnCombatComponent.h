@@ -151,6 +151,14 @@ public:
 	 */
 	virtual void OnWeaponPulledFromTarget(AActor* InteractedActor);
 
+	/**
+	 * @brief 重置战斗状态
+	 * 
+	 * 对象池复用角色时调用，关闭所有碰撞检测并销毁已注册的武器
+	 * 武器会在启动能力重新授予时再次生成并注册
+	 */
+	virtual void ResetCombatState();
+
 protected:
 	virtual void ToggleCurrentEquippedWeaponCollision(bool bShouldEnable);
 
@@ -23,7 +23,21 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void RemoveEnemyDrawnWidgetIfAny();
 
+	// 最近一次广播的血量百分比，供批量绘制的血条层直接读取
+	FORCEINLINE float GetCachedHealthPercent() const
+	{
+		return CachedHealthPercent;
+	}
+
+protected:
+	virtual void BeginPlay() override;
+
 private:
+	UFUNCTION()
+	void OnOwnerCurrentHealthChanged(float NewPercent);
+
 	TArray<UWarriorWidgetBase*> EnemyDrawnWidgets;
+
+	float CachedHealthPercent {1.f};
 	
 };
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "WarriorBehaviorTreeComponent.generated.h"
+
+class UWarriorBehaviorTreeTickSubsystem;
+
+/**
+ * @brief 按帧分组更新的敌人行为树
+ *
+ * 分到某一组的行为树只在该组对应的帧更新，其余帧只累积时间，更新时把累积的时间一并传入
+ * 行为树安排的更新时间落在其他分组的帧上时，顺延到本组的下一帧，不会因间隔与分组周期错开而长期得不到更新
+ * 分组由 UWarriorBehaviorTreeTickSubsystem 按敌人编号分配，靠近玩家或正在攻击的敌人不分组，每帧更新
+ * 显著性级别的行为树更新间隔也在这里生效，作为行为树自身安排的更新间隔的下限，到期后仍需等到本组的帧
+ * warrior.StaggeredBehaviorTreeTick 为 false 时所有行为树每帧更新
+ */
+UCLASS(ClassGroup = (AI), meta = (BlueprintSpawnableComponent))
+class WARRIOR_API UWarriorBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UActorComponent Interface.
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface.
+
+	// warrior.StaggeredBehaviorTreeTick 是否允许分组更新
+	static bool IsStaggeredTickAllowed();
+
+	// INDEX_NONE 表示每帧更新
+	void SetTickBucket(int32 InTickBucket)
+	{
+		TickBucket = InTickBucket;
+	}
+
+	FORCEINLINE int32 GetTickBucket() const
+	{
+		return TickBucket;
+	}
+
+	// 由 AWarriorEnemyCharacter::ApplySignificanceTier 设置，0表示不限制
+	void SetTierTickInterval(float InTierTickInterval)
+	{
+		TierTickInterval = InTierTickInterval;
+	}
+
+private:
+	TWeakObjectPtr<UWarriorBehaviorTreeTickSubsystem> CachedTickSubsystem;
+
+	int32 TickBucket {INDEX_NONE};
+
+	float TierTickInterval {0.f};
+
+	// 非本组的帧累积的时间，下次更新时补上
+	float SkippedDeltaTime {0.f};
+};
@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "WarriorBudgetedSkeletalMeshComponent.generated.h"
+
+/**
+ * @brief 受动画预算分配器管理的敌人骨骼网格体
+ *
+ * 敌人默认使用该网格体，英雄仍使用普通的 USkeletalMeshComponent，始终全速更新
+ * 重要度不由组件自己计算，而是由 UWarriorEnemySignificanceSubsystem 按与玩家的距离统一设置
+ * 是否启用由游戏模式的 AnimationBudgetSettings 与 warrior.AnimationBudget 共同决定
+ */
+UCLASS(ClassGroup = (Rendering), meta = (BlueprintSpawnableComponent))
+class WARRIOR_API UWarriorBudgetedSkeletalMeshComponent : public USkeletalMeshComponentBudgeted
+{
+	GENERATED_BODY()
+
+public:
+	UWarriorBudgetedSkeletalMeshComponent(const FObjectInitializer& ObjectInitializer);
+
+	// warrior.AnimationBudget 是否允许启用动画预算
+	static bool IsAnimationBudgetAllowed();
+
+	// 当前是否已注册到动画预算分配器，由分配器决定何时更新动画
+	bool IsManagedByAnimationBudget() const
+	{
+		return GetAnimationBudgetHandle() != INDEX_NONE;
+	}
+
+	// 从对象池取出时注册、回收时注销，分配器未启用时注册不做任何事
+	void SetRegisteredWithAnimationBudget(bool bShouldRegister);
+};
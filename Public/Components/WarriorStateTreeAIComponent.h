@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/StateTreeAIComponent.h"
+#include "WarriorStateTreeAIComponent.generated.h"
+
+class UWarriorBehaviorTreeTickSubsystem;
+
+/**
+ * @brief 敌人的状态树大脑
+ *
+ * 由 AWarriorAIController 在敌人类型选择状态树时创建，使用 UWarriorStateTreeAIComponentSchema
+ * 每次更新的耗时与行为树一样计入 UWarriorBehaviorTreeTickSubsystem，便于比较两种大脑的开销
+ */
+UCLASS(ClassGroup = (AI), meta = (BlueprintSpawnableComponent))
+class WARRIOR_API UWarriorStateTreeAIComponent : public UStateTreeAIComponent
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UActorComponent Interface.
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface.
+
+	//~ Begin UStateTreeComponent Interface.
+	virtual TSubclassOf<UStateTreeSchema> GetSchema() const override;
+	//~ End UStateTreeComponent Interface.
+
+private:
+	TWeakObjectPtr<UWarriorBehaviorTreeTickSubsystem> CachedTickSubsystem;
+};
@@ -4,9 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include "Perception/AISense_Sight.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
 #include "WarriorAIController.generated.h"
 
+class UStateTree;
+class UWarriorBehaviorTreeComponent;
+class UWarriorStateTreeAIComponent;
+
 /**
  * 
  */
@@ -22,12 +28,54 @@ public:
 	virtual ETeamAttitude ::Type GetTeamAttitudeTowards(const AActor& Other) const override;
 	//~ End IGenericTeamAgentInterface Interface.
 
+	// 进入休眠：暂停行为树、停止移动并关闭视觉感知
+	void EnterDormancy();
+
+	// 退出休眠：恢复行为树与视觉感知
+	void ExitDormancy();
+
+	FORCEINLINE bool IsDormant() const
+	{
+		return bIsDormant;
+	}
+
+	// 由重要度级别决定是否允许视觉感知，最终是否开启还取决于休眠状态与共享目标定位
+	void SetSightPerceptionAllowed(bool bAllowed);
+
+	// 黑板中是否已经记录了目标
+	bool HasTargetActor();
+
+	// 黑板中还没有目标时写入目标，通过缓存的键ID访问黑板，不再每次按名称查找
+	// 运行状态树、没有黑板时目标记录在控制器上
+	void SetTargetActorIfUnset(AActor* InTargetActor);
+
+	// 当前目标，运行行为树时读取黑板中的 TargetActor
+	AActor* GetTargetActor();
+
+	// 已占有的敌人使用状态树时不运行行为树，蓝图中的 RunBehaviorTree 调用直接返回 false
+	virtual bool RunBehaviorTree(UBehaviorTree* BTAsset) override;
+
+	// 当前是否由状态树驱动
+	bool IsRunningStateTreeBrain() const;
+
+	// 按等级调整群体避让的质量与检测范围，进出避让计算需要等到当前移动结束后才会生效
+	void SetCrowdAvoidanceLevel(EWarriorCrowdAvoidanceLevel InLevel);
+
+	FORCEINLINE EWarriorCrowdAvoidanceLevel GetCrowdAvoidanceLevel() const
+	{
+		return CurrentCrowdAvoidanceLevel;
+	}
+
 	
 
 protected:
 
 	virtual void BeginPlay() override;
 
+	virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
+
+	virtual void OnPossess(APawn* InPawn) override;
+
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	UAIPerceptionComponent* EnemyPerceptionComponent;
@@ -48,6 +96,47 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Detour Crowd Avoidance Config", meta = (EditCondition = "bEnableDetourCrowdAvoidance"))
 	float CollisionQueryRange { 600.0f };
 
+	bool bIsDormant { false };
+
+	bool bSightAllowedBySignificance { true };
+
+	// 目标由 UWarriorHeroTargetLocatorSubsystem 统一定位时，控制器自身不再做视觉检测
+	bool bSightDrivenByTargetLocator { false };
+
+	// 开启或关闭视觉感知，综合休眠、重要度与共享目标定位三者的状态
+	void RefreshSightPerception();
+
+	// 取得当前黑板中 TargetActor 的键ID，黑板资产变化时重新解析
+	FBlackboard::FKey GetTargetActorKeyId();
+
+	TWeakObjectPtr<const UBlackboardData> CachedBlackboardAsset;
+
+	FBlackboard::FKey CachedTargetActorKeyId { FBlackboard::InvalidKey };
+
+	// 敌人类型选择了状态树且未被 warrior.EnemyBrainOverride 强制为行为树时返回其状态树资产
+	UStateTree* GetStateTreeBrainFor(const APawn* InPawn) const;
+
+	// 切换到状态树并从头开始运行
+	void StartStateTreeBrain(UStateTree* InStateTree);
+
+	UPROPERTY()
+	UWarriorBehaviorTreeComponent* BehaviorTreeComponent;
+
+	// 第一次使用状态树时才创建
+	UPROPERTY()
+	UWarriorStateTreeAIComponent* StateTreeComponent;
+
+	// 没有黑板时记录的目标
+	TWeakObjectPtr<AActor> NativeTargetActor;
+
+	// 把等级对应的设置应用到 UCrowdFollowingComponent
+	void ApplyCrowdAvoidanceLevel();
+
+	EWarriorCrowdAvoidanceLevel CurrentCrowdAvoidanceLevel { EWarriorCrowdAvoidanceLevel::High };
+
+	// 群体模拟状态只能在空闲时切换，移动中请求的切换记录在这里，移动结束后补上
+	bool bCrowdSimulationStatePending { false };
+
 
 	
  };
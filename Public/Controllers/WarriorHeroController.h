@@ -7,6 +7,8 @@
 #include "GameFramework/PlayerController.h"
 #include "WarriorHeroController.generated.h"
 
+class UWarriorEnemyHealthBarLayerWidget;
+
 /**
  * 
  */
@@ -22,9 +24,21 @@ public:
 	virtual FGenericTeamId GetGenericTeamId() const override;
 	//~ End IGenericTeamAgentInterface Interface.
 
+protected:
+	//~ Begin AActor Interface.
+	virtual void BeginPlay() override;
+	//~ End AActor Interface.
+
+	// 开启 warrior.BatchedEnemyHealthBars 时加入视口的敌人血条层，未指定时使用C++默认类
+	UPROPERTY(EditDefaultsOnly, Category = "UI")
+	TSubclassOf<UWarriorEnemyHealthBarLayerWidget> EnemyHealthBarLayerWidgetClass;
+
 private:
 	FGenericTeamId HeroTeamId;
 
+	UPROPERTY()
+	UWarriorEnemyHealthBarLayerWidget* EnemyHealthBarLayerWidget;
+
 	
 	
 };
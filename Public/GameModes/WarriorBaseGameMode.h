@@ -3,10 +3,412 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Components/SkinnedMeshComponent.h"
 #include "GameFramework/GameModeBase.h"
 #include "WarriorTypes/WarriorEnumTypes.h"
 #include "WarriorBaseGameMode.generated.h"
 
+class AWarriorEnemyCharacter;
+
+// 刷怪点缓存配置，由 UWarriorSpawnPointSubsystem 在世界开始时读取
+USTRUCT(BlueprintType)
+struct FWarriorSpawnPointCacheSettings
+{
+	GENERATED_BODY()
+
+	// 每个 ATargetPoint 周围预先采样的可达点数量
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 SpawnPointsPerTargetPoint {16};
+
+	// 以 ATargetPoint 为圆心的采样半径
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float SampleRadius {400.f};
+
+	// 贴地射线从采样点向上、向下延伸的距离
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float GroundTraceUpDistance {200.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float GroundTraceDownDistance {1000.f};
+
+	// 导航网格重建完成后，在该时间（秒）内没有新的重建才重新采样，避免动态导航网格频繁重建时反复卡顿
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float NavigationRebuildDelay {2.f};
+};
+
+// 波次资源预加载配置，由 UWarriorWaveStreamingSubsystem 读取
+USTRUCT(BlueprintType)
+struct FWarriorWaveStreamingSettings
+{
+	GENERATED_BODY()
+
+	// 除当前波次外，额外提前加载的波次数量
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0"))
+	int32 LookaheadWaves {2};
+
+	// 提前加载的敌人类别所占内存上限（MB），当前波次需要的类别不受此限制
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float MemoryBudgetMB {256.f};
+
+	// 未在 EnemyClassMemoryMB 中配置的敌人类别的内存估算（MB）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EstimatedEnemyClassMemoryMB {32.f};
+
+	// 各敌人类别连同网格、动画、材质等硬引用资源的内存占用（MB），可参考 memreport 或 Size Map 填写
+	// 类默认对象的 GetResourceSizeBytes 不包含这些依赖，无法作为预算依据
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	TMap<TSoftClassPtr<AWarriorEnemyCharacter>, float> EnemyClassMemoryMB;
+};
+
+// 同时存活敌人上限的自适应配置，由 UWarriorPopulationDirectorSubsystem 读取
+USTRUCT(BlueprintType)
+struct FWarriorPopulationDirectorSettings
+{
+	GENERATED_BODY()
+
+	// 帧时间充裕时允许同时存活的敌人数量上限
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 MaxConcurrentEnemies {24};
+
+	// 帧时间超出预算时上限最多降到的数量，保证波次仍能推进
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 MinConcurrentEnemies {4};
+
+	// 游戏线程每帧的时间预算（毫秒）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1.0"))
+	float GameThreadBudgetMs {16.6f};
+
+	// 平滑后的游戏线程时间低于预算的该比例时才提高上限，避免在预算附近来回抖动
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.1", ClampMax = "1.0"))
+	float RaiseCapBudgetRatio {0.8f};
+
+	// 每次调整上限的间隔（秒）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.1"))
+	float CapAdjustInterval {0.5f};
+
+	// 每次调整时上限的变化量
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 CapAdjustStep {2};
+
+	// 帧时间指数平滑系数，越小越平滑
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.01", ClampMax = "1.0"))
+	float FrameTimeSmoothingAlpha {0.1f};
+};
+
+// 单个重要度级别的判定条件与该级别下各组件的更新频率
+USTRUCT(BlueprintType)
+struct FWarriorSignificanceTierSettings
+{
+	GENERATED_BODY()
+
+	// 与玩家的距离不超过该值才能进入此级别，Low 级别忽略此项
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float MaxDistance {2000.f};
+
+	// 屏幕占比（包围球半径相对半屏宽度）不低于该值才能进入此级别，Low 级别忽略此项
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float MinScreenSize {0.02f};
+
+	// 此级别最多容纳的敌人数量，超出的按距离降到下一级别，小于等于0表示不限制
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	int32 MaxEnemies {0};
+
+	// 以下为各组件的 Tick 间隔（秒），0表示每帧更新
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float MovementTickInterval {0.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float AnimationTickInterval {0.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float BehaviorTreeTickInterval {0.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float PerceptionTickInterval {0.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float CrowdFollowingTickInterval {0.f};
+
+	// 是否启用骨骼网格体的 URO（动画更新频率优化）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bEnableUpdateRateOptimizations {false};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	EVisibilityBasedAnimTickOption VisibilityBasedAnimTickOption {EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bEnableSightPerception {true};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bShowHealthWidget {true};
+};
+
+// 敌人重要度分级配置，由 UWarriorEnemySignificanceSubsystem 读取
+USTRUCT(BlueprintType)
+struct FWarriorEnemySignificanceSettings
+{
+	GENERATED_BODY()
+
+	// 重新分级的间隔（秒）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EvaluationInterval {0.25f};
+
+	// 该距离内的敌人视为正在交战，无论是否在屏幕内都保持 High 级别
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float CombatRelevanceRadius {800.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	FWarriorSignificanceTierSettings HighTier;
+
+	// Medium 与 Low 级别的默认值在 AWarriorBaseGameMode 构造函数中设置
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	FWarriorSignificanceTierSettings MediumTier;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	FWarriorSignificanceTierSettings LowTier;
+};
+
+// 敌人休眠配置，由 UWarriorEnemyDormancySubsystem 读取
+USTRUCT(BlueprintType)
+struct FWarriorEnemyDormancySettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bEnableDormancy {true};
+
+	// 检查休眠与唤醒的间隔（秒）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EvaluationInterval {0.5f};
+
+	// 与玩家的距离超过该值的敌人进入休眠，默认大于敌人的视觉半径，休眠的敌人本来也看不到玩家
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float DormancyDistance {6000.f};
+
+	// 休眠的敌人与玩家的距离小于该值时唤醒，小于 DormancyDistance 以免在边界处反复切换
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float WakeDistance {5000.f};
+
+	// 敌人醒来（或生成）后至少保持清醒的时间，受击唤醒的敌人不会立即再次休眠
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float MinAwakeTime {5.f};
+};
+
+// 敌人动画预算配置，由 UWarriorEnemySignificanceSubsystem 应用到引擎的动画预算分配器
+USTRUCT(BlueprintType)
+struct FWarriorAnimationBudgetSettings
+{
+	GENERATED_BODY()
+
+	// 需要在项目中启用 AnimationBudgetAllocator 插件
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bEnableAnimationBudget {false};
+
+	// 所有敌人骨骼网格体每帧动画更新的总预算（毫秒）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.1"))
+	float BudgetMs {1.f};
+
+	// 重要度按与玩家的距离从1线性衰减到0，超过该距离的敌人重要度为0
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1.0"))
+	float MaxSignificanceDistance {5000.f};
+
+	// 超出预算时最低的更新质量，0表示允许降到 MaxTickRate 帧更新一次
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinQuality {0.f};
+
+	// 最多隔多少帧更新一次动画
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 MaxTickRate {10};
+
+	// 跳过的帧是否在两次更新之间插值姿势
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bInterpolateSkippedFrames {true};
+
+	// 同时允许插值的网格体数量上限
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0", EditCondition = "bInterpolateSkippedFrames"))
+	int32 MaxInterpolatedComponents {32};
+};
+
+// 共享目标定位配置，由 UWarriorHeroTargetLocatorSubsystem 读取
+USTRUCT(BlueprintType)
+struct FWarriorHeroTargetLocatorSettings
+{
+	GENERATED_BODY()
+
+	// 启用后敌人控制器关闭各自的视觉感知，改由子系统统一检测是否看到玩家
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bEnableTargetLocator {true};
+
+	// 开始新一轮检测的间隔（秒）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EvaluationInterval {0.25f};
+
+	// 与玩家的距离不超过该值的敌人才可能看到玩家，与原视觉感知的半径一致
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float SightRadius {5000.f};
+
+	// 敌人按该边长的网格分组，同一格内的敌人共用一次视线检测
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1.0"))
+	float ClusterCellSize {500.f};
+
+	// 每帧最多执行的视线检测次数，超出的留到下一帧
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 MaxTracesPerFrame {4};
+
+	// 视线检测起点相对代表敌人位置的高度
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	float EyeHeightOffset {60.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	TEnumAsByte<ECollisionChannel> SightTraceChannel {ECC_Visibility};
+};
+
+USTRUCT(BlueprintType)
+struct FWarriorCrowdAvoidanceSettings
+{
+	GENERATED_BODY()
+
+	// 关闭时所有敌人保持控制器上配置的避让质量与检测范围
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bEnableDynamicCrowdAvoidance {true};
+
+	// 重新分配避让等级的间隔（秒）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EvaluationInterval {0.5f};
+
+	// 与玩家的距离不超过该值的敌人使用控制器上配置的避让质量与检测范围
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float HighLevelDistance {1500.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float MediumLevelDistance {3000.f};
+
+	// 超过该距离的敌人退出避让计算，只作为其他敌人的障碍物
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float LowLevelDistance {5000.f};
+
+	// 与控制器的 DetourCrowdAvoidanceQuality 含义相同，1 为 Low，4 为 High
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (UIMin = "1", UIMax = "4"))
+	int32 MediumAvoidanceQuality {2};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (UIMin = "1", UIMax = "4"))
+	int32 LowAvoidanceQuality {1};
+
+	// Medium 与 Low 等级的邻居检测范围，不会超过控制器上配置的范围
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float ReducedCollisionQueryRange {300.f};
+
+	// 统计局部密度的网格边长，邻居数为周围 3x3 格内的其他敌人数量
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1.0"))
+	float DensityCellSize {400.f};
+
+	// 邻居少于该数量的 Medium 敌人降为 Low，周围没有可避让的对象时不需要精细的采样
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0"))
+	int32 SparseNeighborCount {2};
+
+	// 邻居不少于该数量的 Low 敌人升为 Medium，避免密集的敌人群互相卡住
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0"))
+	int32 DenseNeighborCount {6};
+};
+
+USTRUCT(BlueprintType)
+struct FWarriorAttackTokenSettings
+{
+	GENERATED_BODY()
+
+	// 关闭时所有攻击请求都立即获得名额
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bEnableAttackTokens {true};
+
+	// 同时发起近战攻击的敌人上限
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 MaxMeleeTokens {3};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 MaxRangedTokens {2};
+
+	// 两次发放近战名额之间的最短间隔（秒），把同时到位的敌人的攻击错开到不同帧
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float MeleeGrantInterval {0.15f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float RangedGrantInterval {0.25f};
+
+	// 敌人归还名额后需要等待该时间才能再次获得同类名额，让其他等待的敌人有机会出手
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float HolderRegrantCooldown {1.f};
+
+	// 持有超过该时间仍未归还的名额会被收回，防止行为树异常中断后名额泄漏
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float TokenTimeout {6.f};
+};
+
+USTRUCT(BlueprintType)
+struct FWarriorBehaviorTreeTickSettings
+{
+	GENERATED_BODY()
+
+	// 关闭时所有敌人的行为树每帧更新
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bEnableStaggeredTicking {true};
+
+	// 行为树按敌人编号分到的帧分组数量，每组每 NumTickBuckets 帧更新一次
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 NumTickBuckets {4};
+
+	// 与玩家的距离不超过该值的敌人每帧更新行为树
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float PerFrameDistance {1500.f};
+
+	// 重新分组的间隔（秒）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EvaluationInterval {0.5f};
+
+	// 各分组平均耗时的平滑系数
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float BucketTimeSmoothingAlpha {0.1f};
+};
+
+USTRUCT(BlueprintType)
+struct FWarriorEnemyCrowdSettings
+{
+	GENERATED_BODY()
+
+	// 关闭时所有波次敌人都以完整角色生成
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bEnableCrowdTier {false};
+
+	// 群体实体进入该半径后提升为完整角色
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EngagementRadius {4000.f};
+
+	// 完整角色离开该半径后降级为群体实体，应大于 EngagementRadius 以免在边界上反复切换
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float DemotionRadius {6000.f};
+
+	// 检查提升与降级的间隔（秒）
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EvaluationInterval {0.25f};
+
+	// 每次检查最多提升的实体数量，提升同样受同时存活上限约束
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 MaxPromotionsPerEvaluation {2};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0"))
+	int32 MaxDemotionsPerEvaluation {2};
+
+	// 群体实体之间保持的距离
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float SeparationRadius {150.f};
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float SeparationWeight {1.f};
+
+	// 速度向期望速度靠拢的快慢，数值越大转向越灵敏
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float SteeringResponsiveness {4.f};
+};
+
 /**
  * 
  */
@@ -22,10 +424,98 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game Settings")
 	EWarriorGameDifficulty CurrentGameDifficulty;
 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorSpawnPointCacheSettings SpawnPointCacheSettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorWaveStreamingSettings WaveStreamingSettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorPopulationDirectorSettings PopulationDirectorSettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorEnemySignificanceSettings EnemySignificanceSettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorEnemyDormancySettings EnemyDormancySettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorAnimationBudgetSettings AnimationBudgetSettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorHeroTargetLocatorSettings HeroTargetLocatorSettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorCrowdAvoidanceSettings CrowdAvoidanceSettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorAttackTokenSettings AttackTokenSettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorBehaviorTreeTickSettings BehaviorTreeTickSettings;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	FWarriorEnemyCrowdSettings EnemyCrowdSettings;
+
 public:
 	FORCEINLINE EWarriorGameDifficulty GetCurrentGameDifficulty() const
 	{
 		return CurrentGameDifficulty;
 	}
+
+	FORCEINLINE const FWarriorSpawnPointCacheSettings& GetSpawnPointCacheSettings() const
+	{
+		return SpawnPointCacheSettings;
+	}
+
+	FORCEINLINE const FWarriorWaveStreamingSettings& GetWaveStreamingSettings() const
+	{
+		return WaveStreamingSettings;
+	}
+
+	FORCEINLINE const FWarriorPopulationDirectorSettings& GetPopulationDirectorSettings() const
+	{
+		return PopulationDirectorSettings;
+	}
+
+	FORCEINLINE const FWarriorEnemySignificanceSettings& GetEnemySignificanceSettings() const
+	{
+		return EnemySignificanceSettings;
+	}
+
+	FORCEINLINE const FWarriorEnemyDormancySettings& GetEnemyDormancySettings() const
+	{
+		return EnemyDormancySettings;
+	}
+
+	FORCEINLINE const FWarriorAnimationBudgetSettings& GetAnimationBudgetSettings() const
+	{
+		return AnimationBudgetSettings;
+	}
+
+	FORCEINLINE const FWarriorHeroTargetLocatorSettings& GetHeroTargetLocatorSettings() const
+	{
+		return HeroTargetLocatorSettings;
+	}
+
+	FORCEINLINE const FWarriorCrowdAvoidanceSettings& GetCrowdAvoidanceSettings() const
+	{
+		return CrowdAvoidanceSettings;
+	}
+
+	FORCEINLINE const FWarriorAttackTokenSettings& GetAttackTokenSettings() const
+	{
+		return AttackTokenSettings;
+	}
+
+	FORCEINLINE const FWarriorBehaviorTreeTickSettings& GetBehaviorTreeTickSettings() const
+	{
+		return BehaviorTreeTickSettings;
+	}
+
+	FORCEINLINE const FWarriorEnemyCrowdSettings& GetEnemyCrowdSettings() const
+	{
+		return EnemyCrowdSettings;
+	}
 	
 };
@@ -47,8 +47,142 @@ public:
 	int32 TotalEnemyToSpawnThisWave {1};
 };
 
+// 编译后的单条刷怪定义，敌人类别以下标引用 FWarriorCompiledWaveSchedule::EnemyClasses
+USTRUCT()
+struct FWarriorCompiledSpawnerEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 EnemyClassIndex {INDEX_NONE};
+
+	UPROPERTY()
+	int32 MinPerSpawnCount {0};
+
+	UPROPERTY()
+	int32 MaxPerSpawnCount {0};
+
+	// 本波中截至该条目（含）的 MaxPerSpawnCount 前缀和
+	UPROPERTY()
+	int32 CumulativeMaxPerSpawnCount {0};
+};
+
+// 某一波中单个敌人类别可能生成的最大数量，用于预热对象池
+USTRUCT()
+struct FWarriorCompiledWaveClassUsage
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 EnemyClassIndex {INDEX_NONE};
+
+	UPROPERTY()
+	int32 MaxPossibleSpawnCount {0};
+};
+
+USTRUCT()
+struct FWarriorCompiledWavePlan
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 FirstEntryIndex {0};
+
+	UPROPERTY()
+	int32 NumEntries {0};
+
+	UPROPERTY()
+	int32 FirstClassUsageIndex {0};
+
+	UPROPERTY()
+	int32 NumClassUsages {0};
+
+	UPROPERTY()
+	int32 TotalEnemyToSpawn {0};
+
+	// 之前所有波次的 TotalEnemyToSpawn 前缀和
+	UPROPERTY()
+	int32 EnemiesSpawnedBeforeThisWave {0};
+};
+
+/**
+ * @brief 编译后的波次计划
+ *
+ * BeginPlay 时由 EnemyWaveSpawnerDataTable 一次性编译而来，按波次顺序平铺存放
+ * 运行时只做数组下标访问，不再构造 FName 或查找 DataTable 行
+ */
+USTRUCT()
+struct FWarriorCompiledWaveSchedule
+{
+	GENERATED_BODY()
+
+	// 按 Wave1..WaveN 的行名顺序编译，任何错误都写入 OutErrors，返回false表示数据表不可用
+	bool Compile(const UDataTable* InWaveSpawnerDataTable, TArray<FText>& OutErrors);
+
+	int32 GetNumWaves() const
+	{
+		return WavePlans.Num();
+	}
+
+	UPROPERTY()
+	TArray<TSoftClassPtr<AWarriorEnemyCharacter>> EnemyClasses;
+
+	UPROPERTY()
+	TArray<FWarriorCompiledSpawnerEntry> SpawnerEntries;
+
+	UPROPERTY()
+	TArray<FWarriorCompiledWaveClassUsage> ClassUsages;
+
+	UPROPERTY()
+	TArray<FWarriorCompiledWavePlan> WavePlans;
+
+	UPROPERTY()
+	int32 TotalEnemiesAllWaves {0};
+};
+
+// 等待生成的敌人请求，入队时已计入本波生成总数
+USTRUCT()
+struct FWarriorPendingEnemySpawn
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 EnemyClassIndex {INDEX_NONE};
+
+	// 入队时间，用于统计从请求到实际生成的延迟
+	double EnqueueTimeSeconds {0.0};
+};
+
+USTRUCT(BlueprintType)
+struct FWarriorEnemySpawnQueueStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 CurrentQueueDepth {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 MaxQueueDepth {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SpawnedFromQueue {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 FailedSpawns {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	float LastSpawnLatencyMs {0.f};
+
+	UPROPERTY(BlueprintReadOnly)
+	float MaxSpawnLatencyMs {0.f};
+
+	UPROPERTY(BlueprintReadOnly)
+	float AverageSpawnLatencyMs {0.f};
+};
+
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSurvivalGameModeStateChangedDelegate, EWarriorSurvivalGameModeState, CurrentState);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnEnemyPopulationChangedDelegate, int32, LiveEnemies, int32, PendingEnemies, int32, ConcurrentEnemyCap);
 
 /**
  * 
@@ -58,21 +192,58 @@ class WARRIOR_API AWarriorSurvivalGameMode : public AWarriorBaseGameMode
 {
 	GENERATED_BODY()
 
+public:
+	AWarriorSurvivalGameMode();
+
 protected:
 	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// 状态切换钩子，先调用旧状态的 OnExit 再调用新状态的 OnEnter，最后广播 OnSurvivalGameModeStateChanged
+	virtual void OnExitSurvivalGameModeState(EWarriorSurvivalGameModeState InOldState);
+	virtual void OnEnterSurvivalGameModeState(EWarriorSurvivalGameModeState InNewState);
+
+#if WITH_EDITOR
+	//~ Begin UObject Interface.
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+	//~ End UObject Interface.
+#endif
 
 private:
+	using FStateTimerCallback = void (AWarriorSurvivalGameMode::*)();
+
 	void SetCurrentSurvivalGameModeState(EWarriorSurvivalGameModeState InState);
+	void StartStateTimer(float InDuration, FStateTimerCallback InTimerCallback);
+	void OnSpawnNewWaveWaitFinished();
+	void OnSpawnEnemiesDelayFinished();
+	void OnWaveCompletedWaitFinished();
+	void TryStartSpawningCurrentWave();
+	void ScheduleSpawnQueueProcessing();
 	bool HasFinishedAllWaves() const;
 	void PreloadNextWaveEnemies();
-	FWarriorEnemyWaveSpawnerTableRow* GetCurrentWaveSpawnerTableRow() const;
-	int32 TrySpawnWaveEnemies();
+	bool IsCurrentWaveReady() const;
+	void OnWaveAssetsReady(int32 InWaveIndex);
+	const FWarriorCompiledWavePlan& GetCurrentWavePlan() const;
+	int32 EnqueueWaveEnemySpawns();
+	void ProcessPendingEnemySpawnQueue();
+	// bSpawnAsCrowdEntity 为真时不生成完整角色，直接作为群体实体加入
+	bool SpawnQueuedEnemy(const FWarriorPendingEnemySpawn& InPendingSpawn, bool bSpawnAsCrowdEntity);
 	bool ShouldKeepSpawnEnemies() const;
+	void CheckWaveProgress();
+
+	// 计入波次的敌人死亡回收或被销毁后离开登记表时调用
+	void OnEnemyUnregistered(AWarriorEnemyCharacter* InUnregisteredEnemy, bool bWasWaveEnemy);
 
-	UFUNCTION()
-	void OnEnemyDestroyed(AActor* DestroyedActor);
+	// 当前波次仍存活（含死亡流程尚未结束）的敌人数量，包括远处的群体实体
+	int32 GetNumLiveWaveEnemies() const;
+
+	// 当前波次中以完整角色存在的敌人数量，同时存活上限只约束这一部分
+	int32 GetNumLiveWaveCharacters() const;
+
+	// 同时存活上限变化后继续处理被推迟的生成请求
+	void OnConcurrentEnemyCapChanged(int32 InNewConcurrentEnemyCap);
+	void BroadcastEnemyPopulationChanged();
 	
 	UPROPERTY()
 	EWarriorSurvivalGameModeState CurrentSurvivalGameModeState;
@@ -80,6 +251,10 @@ private:
 	UPROPERTY(BlueprintAssignable, BlueprintCallable)
 	FOnSurvivalGameModeStateChangedDelegate OnSurvivalGameModeStateChanged;
 
+	// 存活数量、等待生成数量或同时存活上限变化时广播，供HUD显示
+	UPROPERTY(BlueprintAssignable, BlueprintCallable)
+	FOnEnemyPopulationChangedDelegate OnEnemyPopulationChanged;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition", meta = (AllowPrivateAccess = "true"))
 	UDataTable* EnemyWaveSpawnerDataTable;
 
@@ -89,18 +264,9 @@ private:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition", meta = (AllowPrivateAccess = "true"))
 	int32 CurrentWaveCount {1};
 
-	UPROPERTY()
-	int32 CurrentSpawnedEnemiesCounter {0};
-
 	UPROPERTY()
 	int32 TotalSpawnedEnemiesThisWaveCounter {0};
 
-	UPROPERTY()
-	TArray<AActor*> TargetPointArray;
-
-	UPROPERTY()
-	float TimePassedSinceStart {0.f};
-
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition", meta = (AllowPrivateAccess = "true"))
 	float SpawnNewWaveWaitTime {5.f};
 
@@ -111,23 +277,87 @@ private:
 	float WaveCompletedWaitTime {5.f};
 
 	UPROPERTY()
-	TMap<TSoftClassPtr<AWarriorEnemyCharacter>, UClass*> PreLoadedEnemyClassMap;
+	FWarriorCompiledWaveSchedule CompiledWaveSchedule;
+
+
+	// 每帧最多生成的敌人数量，小于等于0表示不限制数量，只受时间预算约束
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition|SpawnBudget", meta = (AllowPrivateAccess = "true"))
+	int32 MaxEnemySpawnsPerFrame {2};
+
+	// 每帧用于生成敌人的时间预算（毫秒），每帧至少会生成一个敌人以保证队列前进
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition|SpawnBudget", meta = (AllowPrivateAccess = "true", ClampMin = "0.1"))
+	float EnemySpawnFrameBudgetMs {2.f};
+
+	UPROPERTY()
+	TArray<FWarriorPendingEnemySpawn> PendingEnemySpawnQueue;
+
+	FWarriorEnemySpawnQueueStats SpawnQueueStats;
+
+	double TotalSpawnLatencyMs {0.0};
+
+	// 当前状态的计时器，切换状态时清除
+	FTimerHandle StateTimerHandle;
+
+	FStateTimerCallback StateTimerCallback {nullptr};
+
+	bool bSpawnEnemiesDelayFinished {false};
+
+	bool bSpawnQueueProcessingScheduled {false};
+
+	// 达到同时存活上限后暂停处理队列，直到有敌人离场或上限提高
+	bool bSpawnQueueDeferredByPopulationCap {false};
+
+	bool bWaveFlowPaused {false};
+
+	// 波次流程计时的时间缩放，用于基准测试时快进
+	float WaveFlowTimeScale {1.f};
 
 public:
-	UFUNCTION(BlueprintCallable)
-	void RegisterSpawnedEnemy(const TArray<AWarriorEnemyCharacter*>& InEnemyToRegister);
-	
-};
+	// 暂停波次流程计时，已经排队的敌人仍会继续生成
+	UFUNCTION(Exec, BlueprintCallable, Category = "Warrior|Survival")
+	void WarriorPauseWaveFlow();
 
-inline void AWarriorSurvivalGameMode::RegisterSpawnedEnemy(const TArray<AWarriorEnemyCharacter*>& InEnemyToRegister)
-{
-	for (AWarriorEnemyCharacter* SpawnedEnemy : InEnemyToRegister)
+	UFUNCTION(Exec, BlueprintCallable, Category = "Warrior|Survival")
+	void WarriorResumeWaveFlow();
+
+	// 立即结束当前状态的等待计时
+	UFUNCTION(Exec, BlueprintCallable, Category = "Warrior|Survival")
+	void WarriorFastForwardWaveFlow();
+
+	// 设置波次等待计时的时间缩放，例如设为4会让所有等待时间缩短为原来的四分之一
+	UFUNCTION(Exec, BlueprintCallable, Category = "Warrior|Survival")
+	void WarriorSetWaveFlowTimeScale(float InTimeScale);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Survival")
+	EWarriorSurvivalGameModeState GetCurrentSurvivalGameModeState() const
 	{
-		if (SpawnedEnemy)
-		{
-			CurrentSpawnedEnemiesCounter++;
+		return CurrentSurvivalGameModeState;
+	}
+
+	FORCEINLINE int32 GetCurrentWaveCount() const
+	{
+		return CurrentWaveCount;
+	}
+
+	FORCEINLINE int32 GetTotalWavesToSpawn() const
+	{
+		return TotalWavesToSpawn;
+	}
+
+	// 已计入本波但因帧预算或同时存活上限尚未生成的敌人数量
+	UFUNCTION(BlueprintPure, Category = "Warrior|Survival")
+	int32 GetNumPendingEnemySpawns() const
+	{
+		return PendingEnemySpawnQueue.Num();
+	}
 
-			SpawnedEnemy->OnDestroyed.AddUniqueDynamic(this, &AWarriorSurvivalGameMode::OnEnemyDestroyed);
-		}
+	UFUNCTION(BlueprintPure, Category = "Warrior|Survival")
+	FWarriorEnemySpawnQueueStats GetEnemySpawnQueueStats() const
+	{
+		return SpawnQueueStats;
 	}
-}
+
+	UFUNCTION(BlueprintCallable)
+	void RegisterSpawnedEnemy(const TArray<AWarriorEnemyCharacter*>& InEnemyToRegister);
+	
+};
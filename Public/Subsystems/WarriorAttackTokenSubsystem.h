@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WarriorAttackTokenSubsystem.generated.h"
+
+class AWarriorEnemyCharacter;
+
+USTRUCT(BlueprintType)
+struct FWarriorAttackTokenStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 TokensGranted {0};
+
+	// 因名额已满或发放间隔未到而开始等待的次数，同一敌人在拿到名额前反复被拒绝只计一次
+	UPROPERTY(BlueprintReadOnly)
+	int32 TokenWaits {0};
+
+	// 超时未归还而被收回的名额数量
+	UPROPERTY(BlueprintReadOnly)
+	int32 TokensReclaimed {0};
+
+	// 等待过的敌人从第一次被拒绝到获得名额的平均时间（秒）
+	UPROPERTY(BlueprintReadOnly)
+	float AverageWaitTime {0.f};
+
+	UPROPERTY(BlueprintReadOnly)
+	float MaxWaitTime {0.f};
+};
+
+/**
+ * @brief 攻击名额调度
+ *
+ * 敌人发起攻击前向本子系统申请对应类型的名额，同时持有名额的敌人数量与名额发放的频率都有上限
+ * 围在玩家身边的敌人不会在同一帧一起激活攻击能力，每帧的蒙太奇、效果与命中检测开销有确定的上界
+ * 行为树中通过 UBTDecorator_AttackToken 申请名额，分支结束时归还
+ */
+UCLASS()
+class WARRIOR_API UWarriorAttackTokenSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface.
+
+	// 申请名额，已经持有时直接返回 true；被拒绝时开始记录等待
+	bool TryAcquireAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType);
+
+	// 只检查现在申请能否拿到名额，不发放名额也不记录等待
+	bool CanAcquireAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType) const;
+
+	// 记录该敌人开始等待名额，已经在等待时不重复计数，拿到名额或归还时结束等待
+	void MarkWaitingForAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType);
+
+	void ReleaseAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType);
+
+	bool HasAttackToken(const AActor* InHolder, EWarriorAttackTokenType InTokenType) const;
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Attack Token")
+	int32 GetNumActiveTokens(EWarriorAttackTokenType InTokenType) const
+	{
+		return InTokenType < EWarriorAttackTokenType::MAX ? TokenPools[static_cast<int32>(InTokenType)].Holders.Num() : 0;
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Attack Token")
+	FWarriorAttackTokenStats GetAttackTokenStats() const
+	{
+		return TokenStats;
+	}
+
+private:
+	struct FAttackTokenHolder
+	{
+		TObjectKey<AActor> Holder;
+		double GrantTime;
+	};
+
+	// 同一类型名额的发放状态
+	struct FAttackTokenPool
+	{
+		TArray<FAttackTokenHolder, TInlineAllocator<4>> Holders;
+
+		// 正在等待名额的敌人第一次被拒绝的时间
+		TMap<TObjectKey<AActor>, double> WaitStartTimes;
+
+		// 敌人最近一次归还名额的时间
+		TMap<TObjectKey<AActor>, double> ReleaseTimes;
+
+		double LastGrantTime {-UE_BIG_NUMBER};
+
+		int32 FindHolderIndex(const TObjectKey<AActor>& InHolder) const
+		{
+			return Holders.IndexOfByPredicate([&InHolder](const FAttackTokenHolder& Holder) { return Holder.Holder == InHolder; });
+		}
+	};
+
+	int32 GetMaxTokens(EWarriorAttackTokenType InTokenType) const;
+
+	// 名额数量、发放间隔与归还后的冷却是否都允许向该敌人发放，超时未归还的名额不计入已发放数量
+	bool CanGrantAttackToken(const FAttackTokenPool& InTokenPool, const TObjectKey<AActor>& InHolder, EWarriorAttackTokenType InTokenType, double InCurrentTime) const;
+	float GetGrantInterval(EWarriorAttackTokenType InTokenType) const;
+
+	// 收回超时未归还的名额
+	void ReclaimExpiredTokens(FAttackTokenPool& InTokenPool, double InCurrentTime);
+
+	void RecordWaitTime(double InWaitTime);
+
+	// 离开登记表的敌人（死亡回收或销毁）归还所有名额
+	void OnEnemyUnregistered(AWarriorEnemyCharacter* InEnemy, bool bWasWaveEnemy);
+
+	FWarriorAttackTokenSettings TokenSettings;
+
+	FWarriorAttackTokenStats TokenStats;
+
+	FAttackTokenPool TokenPools[static_cast<int32>(EWarriorAttackTokenType::MAX)];
+
+	double TotalWaitTime {0.0};
+
+	int32 NumWaitedGrants {0};
+};
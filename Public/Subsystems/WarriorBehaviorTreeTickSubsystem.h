@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorBehaviorTreeTickSubsystem.generated.h"
+
+/**
+ * @brief 敌人行为树的分帧更新调度
+ *
+ * 所有敌人的行为树在同一帧更新时，服务与任务的开销集中成尖峰
+ * 每隔 EvaluationInterval 按敌人的对象编号把行为树分到 NumTickBuckets 个帧分组，第 N 帧只更新编号对应 N % NumTickBuckets 的分组
+ * 靠近玩家或持有攻击名额的敌人不分组，每帧更新，保证交战中的反应速度
+ * 每帧统计所有行为树的更新耗时并按分组平滑，分组之间的差值反映负载是否均匀
+ */
+UCLASS()
+class WARRIOR_API UWarriorBehaviorTreeTickSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface.
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+	// 立即为所有存活敌人重新分组
+	void EvaluateTickBuckets();
+
+	FORCEINLINE bool IsTickBucketActive(int32 InTickBucket) const
+	{
+		return InTickBucket == GetActiveTickBucket();
+	}
+
+	// 由 UWarriorBehaviorTreeComponent 与 UWarriorStateTreeAIComponent 在每次实际更新后调用
+	void RecordBehaviorTreeTick(double InTickSeconds)
+	{
+		FrameTickSeconds += InTickSeconds;
+	}
+
+	// 上一帧所有敌人大脑（行为树与状态树）的更新耗时（毫秒）
+	FORCEINLINE float GetLastFrameBrainTickMs() const
+	{
+		return LastFrameBrainTickMs;
+	}
+
+	// 各分组平滑后的行为树更新耗时（毫秒）
+	UFUNCTION(BlueprintPure, Category = "Warrior|Behavior Tree")
+	float GetTickBucketAverageMs(int32 InTickBucket) const
+	{
+		return BucketAverageMs.IsValidIndex(InTickBucket) ? BucketAverageMs[InTickBucket] : 0.f;
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Behavior Tree")
+	int32 GetNumTickBuckets() const
+	{
+		return BucketAverageMs.Num();
+	}
+
+private:
+	FORCEINLINE int32 GetActiveTickBucket() const
+	{
+		return static_cast<int32>(GFrameCounter % static_cast<uint64>(BucketAverageMs.Num()));
+	}
+
+	FWarriorBehaviorTreeTickSettings TickSettings;
+
+	TArray<float> BucketAverageMs;
+
+	double FrameTickSeconds {0.0};
+
+	float LastFrameBrainTickMs {0.f};
+
+	float TimeSinceLastEvaluation {0.f};
+};
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
+#include "WarriorBrainBenchmarkSubsystem.generated.h"
+
+class AWarriorEnemyCharacter;
+
+// 一种大脑在一个敌人数量下的测量结果
+USTRUCT()
+struct FWarriorBrainBenchmarkSample
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EWarriorEnemyBrainType BrainType {EWarriorEnemyBrainType::BehaviorTree};
+
+	UPROPERTY()
+	int32 NumAgents {0};
+
+	UPROPERTY()
+	int32 NumFrames {0};
+
+	UPROPERTY()
+	float BrainTickMeanMs {0.f};
+
+	UPROPERTY()
+	float BrainTickP95Ms {0.f};
+
+	// 每个敌人每帧的大脑更新耗时（微秒）
+	UPROPERTY()
+	float PerAgentMicroseconds {0.f};
+
+	UPROPERTY()
+	float FrameTimeMeanMs {0.f};
+};
+
+/**
+ * @brief 行为树与状态树大脑的开销对比
+ *
+ * 仅在命令行带有 -WarriorBrainBenchmark 时创建，地图的游戏模式不应自行生成波次，例如：
+ * UnrealEditor-Cmd Warrior.uproject BenchmarkMap -game -nullrhi -unattended -WarriorBrainBenchmark -WarriorBrainBenchmarkEnemy=/Game/Characters/BP_Enemy.BP_Enemy_C
+ *
+ * 依次以行为树与状态树（通过 warrior.EnemyBrainOverride 强制）在玩家周围生成 50/100/200 个敌人
+ * 预热后记录每帧所有大脑的更新耗时，换算为每个敌人的平均开销，结果以CSV写入 Saved/Profiling/WarriorBrainBenchmark
+ * 默认关闭行为树的分帧更新，两种大脑都每帧更新，加 -WarriorBrainBenchmarkStaggered 保留分帧
+ *
+ * 可选参数：
+ * -WarriorBrainBenchmarkCounts=50,100,200  -WarriorBrainBenchmarkSeconds=10  -WarriorBrainBenchmarkWarmup=3
+ * -WarriorBrainBenchmarkRadius=2500
+ */
+UCLASS()
+class WARRIOR_API UWarriorBrainBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	//~ End USubsystem Interface.
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface.
+
+private:
+	enum class EBenchmarkPhase : uint8
+	{
+		NotStarted,
+		WarmingUp,
+		Measuring,
+		Finished
+	};
+
+	void BeginSample();
+	void EndSample();
+	void SpawnAgents(int32 InNumAgents);
+	void DestroyAgents();
+	void FinishBenchmark();
+	void WriteReport() const;
+
+	static void SetBrainOverride(EWarriorEnemyBrainType InBrainType);
+
+	UPROPERTY()
+	TSubclassOf<AWarriorEnemyCharacter> EnemyClass;
+
+	UPROPERTY()
+	TArray<AWarriorEnemyCharacter*> SpawnedAgents;
+
+	UPROPERTY()
+	TArray<FWarriorBrainBenchmarkSample> Samples;
+
+	TArray<int32> AgentCounts;
+
+	// 待测的（大脑, 数量）组合中下一个的下标
+	int32 NextSampleIndex {0};
+
+	FWarriorBrainBenchmarkSample CurrentSample;
+
+	TArray<float> CurrentBrainTickMs;
+	double CurrentFrameTimeSumMs {0.0};
+
+	float MeasureSeconds {10.f};
+	float WarmupSeconds {3.f};
+	float SpawnRadius {2500.f};
+
+	float PhaseElapsedSeconds {0.f};
+
+	EBenchmarkPhase Phase {EBenchmarkPhase::NotStarted};
+};
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorCrowdAvoidanceSubsystem.generated.h"
+
+/**
+ * @brief 按距离与局部密度分配群体避让等级
+ *
+ * 群体模拟的开销随参与避让的代理数量与各自的采样质量快速增长，而远处敌人的避让细节玩家看不到
+ * 每隔 EvaluationInterval 遍历存活敌人登记表，按与玩家的距离分为 High/Medium/Low/Off 四级
+ * 再按周围网格内的敌人数量微调：稀疏处的 Medium 降为 Low，密集处的 Low 升为 Medium
+ * Off 等级的敌人退出避让计算，只作为其他敌人的障碍物
+ */
+UCLASS()
+class WARRIOR_API UWarriorCrowdAvoidanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface.
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+	// 立即为所有存活敌人重新分配避让等级
+	void EvaluateCrowdAvoidance();
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Crowd")
+	int32 GetNumEnemiesAtLevel(EWarriorCrowdAvoidanceLevel InLevel) const
+	{
+		return InLevel < EWarriorCrowdAvoidanceLevel::MAX ? NumEnemiesPerLevel[static_cast<int32>(InLevel)] : 0;
+	}
+
+	// 上一帧群体模拟的耗时（毫秒），项目未使用 UWarriorCrowdManager 时返回 0
+	UFUNCTION(BlueprintPure, Category = "Warrior|Crowd")
+	float GetCrowdSimulationTimeMs() const;
+
+private:
+	EWarriorCrowdAvoidanceLevel GetLevelForDistance(float InDistanceSquared) const;
+
+	FORCEINLINE FIntPoint GetDensityCell(const FVector& InLocation) const
+	{
+		return FIntPoint(FMath::FloorToInt(InLocation.X / CrowdAvoidanceSettings.DensityCellSize),
+			FMath::FloorToInt(InLocation.Y / CrowdAvoidanceSettings.DensityCellSize));
+	}
+
+	FWarriorCrowdAvoidanceSettings CrowdAvoidanceSettings;
+
+	// 每格中的存活敌人数量，在各次分级之间复用
+	TMap<FIntPoint, int32> EnemyCountByCell;
+
+	int32 NumEnemiesPerLevel[static_cast<int32>(EWarriorCrowdAvoidanceLevel::MAX)] {};
+
+	float TimeSinceLastEvaluation {0.f};
+};
@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorEnemyCrowdSubsystem.generated.h"
+
+class AWarriorEnemyCharacter;
+class UInstancedStaticMeshComponent;
+
+// 群体实体使用的一个敌人类别，实体以下标引用
+USTRUCT()
+struct FWarriorCrowdEnemyClass
+{
+	GENERATED_BODY()
+
+	TSoftClassPtr<AWarriorEnemyCharacter> SoftEnemyClass;
+
+	UPROPERTY()
+	UClass* LoadedEnemyClass {nullptr};
+
+	// 取自类别默认对象的最大行走速度
+	float MaxSpeed {0.f};
+
+	// 该类别所有实体共用的实例化网格体，类别没有设置 CrowdProxyMesh 时为空
+	UPROPERTY()
+	UInstancedStaticMeshComponent* ProxyMeshComponent {nullptr};
+
+	// 每帧复用的实例变换
+	TArray<FTransform> InstanceTransforms;
+};
+
+USTRUCT(BlueprintType)
+struct FWarriorEnemyCrowdStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SpawnedAsCrowdEntities {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Promotions {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 FailedPromotions {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Demotions {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 MaxCrowdEntities {0};
+};
+
+/**
+ * @brief 远处波次敌人的轻量群体层
+ *
+ * 完整的敌人角色带有ASC、属性集、移动组件、骨骼网格体、感知、血条与攻击判定，同时存在的数量很有限
+ * 远离玩家的波次敌人只以群体实体存在：位置、速度、血量、类别与目标按数组分别存放，由简单的转向计算统一移动
+ * 并按类别用实例化静态网格体批量显示
+ * 实体进入 EngagementRadius 后从对象池取出完整角色替换，完整角色离开 DemotionRadius 后回收进池并还原为实体
+ * 群体实体计入波次存活数量，但不占用同时存活上限
+ */
+UCLASS()
+class WARRIOR_API UWarriorEnemyCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface.
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+	FORCEINLINE bool IsCrowdTierEnabled() const
+	{
+		return CrowdSettings.bEnableCrowdTier;
+	}
+
+	// 在该地面位置生成的波次敌人是否应当以群体实体开始
+	bool ShouldSpawnAsCrowdEntity(const FVector& InGroundLocation) const;
+
+	// 以群体实体生成一个波次敌人，InGroundLocation 为地面位置
+	void AddCrowdEntity(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, UClass* InLoadedEnemyClass,
+		const FVector& InGroundLocation);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Crowd")
+	int32 GetNumCrowdEntities() const
+	{
+		return EntityLocations.Num();
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Crowd")
+	FWarriorEnemyCrowdStats GetEnemyCrowdStats() const
+	{
+		return CrowdStats;
+	}
+
+private:
+	int32 AddEntity(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, UClass* InLoadedEnemyClass,
+		const FVector& InGroundLocation, float InHealthPercent);
+
+	int32 FindOrAddCrowdEnemyClass(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, UClass* InLoadedEnemyClass);
+
+	// 按目标与分离力更新所有实体的速度与位置
+	void UpdateSteering(float DeltaTime);
+
+	// 按空间网格重新计算实体之间的分离力，随提升与降级检查一起低频执行
+	void UpdateSeparation();
+
+	// 实体只在水平面上移动，低频地把高度贴合到导航网格
+	// 离开导航网格或与上次贴合位置之间被墙体、悬崖边缘隔开的实体退回上次贴合的位置并停下
+	void SnapEntitiesToNavigation();
+
+	void UpdateProxyInstances();
+
+	void PromoteEntities(const FVector& InHeroLocation);
+	void DemoteEnemies(const FVector& InHeroLocation);
+
+	void RemoveEntityAt(int32 InEntityIndex);
+
+	FORCEINLINE FIntPoint GetSeparationCell(const FVector& InLocation) const
+	{
+		return FIntPoint(FMath::FloorToInt(InLocation.X / SeparationCellSize), FMath::FloorToInt(InLocation.Y / SeparationCellSize));
+	}
+
+	FWarriorEnemyCrowdSettings CrowdSettings;
+
+	FWarriorEnemyCrowdStats CrowdStats;
+
+	UPROPERTY()
+	TArray<FWarriorCrowdEnemyClass> CrowdEnemyClasses;
+
+	// 承载各类别实例化网格体的Actor，首次需要显示实体时生成
+	UPROPERTY()
+	AActor* ProxyMeshActor;
+
+	// 以下数组一一对应，每个下标为一个群体实体
+	TArray<FVector> EntityLocations;
+	TArray<FVector> EntityVelocities;
+	TArray<FVector> EntitySeparations;
+	TArray<float> EntityHealthPercents;
+	TArray<int32> EntityClassIndices;
+	TArray<FVector> EntityTargetLocations;
+
+	// 上次成功贴合到导航网格的位置
+	TArray<FVector> EntityNavLocations;
+
+	// 每格中的实体下标，在各次分离计算之间复用
+	TMap<FIntPoint, TArray<int32>> EntitiesByCell;
+
+	float SeparationCellSize {150.f};
+
+	// 复用的候选数组，避免每次检查分配内存
+	TArray<TPair<float, int32>> PromotionCandidates;
+	TArray<AWarriorEnemyCharacter*> DemotionCandidates;
+
+	float TimeSinceLastEvaluation {0.f};
+};
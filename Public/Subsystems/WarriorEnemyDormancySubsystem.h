@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorEnemyDormancySubsystem.generated.h"
+
+/**
+ * @brief 敌人休眠管理
+ *
+ * 每隔 EvaluationInterval 遍历存活敌人登记表，远离玩家且清醒足够久的敌人进入休眠，休眠的敌人回到 WakeDistance 内时唤醒
+ * 受击唤醒与显式唤醒由敌人自身处理，这里只负责基于距离的判定与统计
+ */
+UCLASS()
+class WARRIOR_API UWarriorEnemyDormancySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface.
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+	// 立即按距离更新所有存活敌人的休眠状态
+	void EvaluateDormancy();
+
+	// 唤醒所有休眠的敌人，例如进入新的波次或过场结束时
+	UFUNCTION(BlueprintCallable, Category = "Warrior|Dormancy")
+	void WakeAllEnemies();
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Dormancy")
+	int32 GetNumDormantEnemies() const
+	{
+		return NumDormantEnemies;
+	}
+
+private:
+	FWarriorEnemyDormancySettings DormancySettings;
+
+	int32 NumDormantEnemies {0};
+
+	float TimeSinceLastEvaluation {0.f};
+};
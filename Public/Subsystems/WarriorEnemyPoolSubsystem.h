@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorEnemyPoolSubsystem.generated.h"
+
+class AWarriorEnemyCharacter;
+
+DECLARE_DELEGATE_OneParam(FOnEnemySummonedDelegate, AWarriorEnemyCharacter* /*SummonedEnemy*/);
+
+// 一次召唤请求，在预算内从池中取出敌人并放置到 SpawnOrigin 附近的缓存刷怪点
+struct FWarriorEnemySummonRequest
+{
+	TSoftClassPtr<AWarriorEnemyCharacter> SoftEnemyClass;
+
+	UClass* LoadedEnemyClass {nullptr};
+
+	FVector SpawnOrigin {FVector::ZeroVector};
+
+	float RandomSpawnRadius {0.f};
+
+	FRotator SpawnRotation {FRotator::ZeroRotator};
+
+	// 生成失败时传入空指针；请求方已销毁导致委托失效时，该请求会被直接丢弃
+	FOnEnemySummonedDelegate OnEnemySummoned;
+};
+
+struct FWarriorEnemyPrewarmRequest
+{
+	TSoftClassPtr<AWarriorEnemyCharacter> SoftEnemyClass;
+
+	UClass* LoadedEnemyClass {nullptr};
+
+	int32 DesiredDormantCount {0};
+};
+
+USTRUCT()
+struct FWarriorEnemyPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AWarriorEnemyCharacter*> DormantEnemies;
+};
+
+USTRUCT(BlueprintType)
+struct FWarriorEnemyPoolStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 PoolHits {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 PoolMisses {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 ReleasedToPool {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 PrewarmedEnemies {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SummonedEnemies {0};
+};
+
+/**
+ * @brief 敌人对象池
+ *
+ * 以 TSoftClassPtr<AWarriorEnemyCharacter> 为键，缓存休眠中的敌人实例
+ * 敌人死亡后回收进池，下次生成时直接复用，避免 SpawnActor/Destroy 带来的卡顿与 GC 峰值
+ * 召唤类能力的敌人类别在此统一加载并常驻，召唤与延迟预热请求按每帧预算分摊处理
+ */
+UCLASS()
+class WARRIOR_API UWarriorEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface.
+
+	// 加载敌人类别并在本世界内常驻，已加载时立即调用 InOnLoaded，多个请求方共享同一份加载结果
+	void RequestEnemyClassLoad(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, FStreamableDelegate InOnLoaded);
+
+	// 排队一次召唤，在之后的帧中按预算处理
+	void EnqueueSummon(FWarriorEnemySummonRequest&& InSummonRequest);
+
+	// 排队预热，在召唤请求处理完后按预算逐个生成休眠敌人
+	void QueuePrewarmEnemies(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, UClass* InLoadedEnemyClass, int32 InDesiredDormantCount);
+
+	// 预先生成休眠敌人，使该类别的池中至少有 InDesiredDormantCount 个可用实例
+	void PrewarmEnemies(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, UClass* InLoadedEnemyClass, int32 InDesiredDormantCount);
+
+	// 从池中取出一个敌人并放置到指定位置，池为空时退化为直接生成
+	AWarriorEnemyCharacter* AcquireEnemy(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass, UClass* InLoadedEnemyClass,
+		const FVector& InLocation, const FRotator& InRotation);
+
+	// 将敌人回收进池，返回false表示该敌人不受池管理，调用方应自行销毁
+	bool ReleaseEnemy(AWarriorEnemyCharacter* InEnemyToRelease);
+
+	// 销毁该类别的全部休眠敌人并停止回收该类别，使其资源可以被卸载
+	void FlushDormantEnemies(const TSoftClassPtr<AWarriorEnemyCharacter>& InSoftEnemyClass);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|EnemyPool")
+	int32 GetNumDormantEnemies(TSoftClassPtr<AWarriorEnemyCharacter> InSoftEnemyClass) const;
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|EnemyPool")
+	FWarriorEnemyPoolStats GetEnemyPoolStats() const
+	{
+		return EnemyPoolStats;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Warrior|EnemyPool")
+	void ResetEnemyPoolStats();
+
+private:
+	AWarriorEnemyCharacter* SpawnDormantEnemy(UClass* InLoadedEnemyClass) const;
+
+	void OnEnemyClassLoadCompleted(TSoftClassPtr<AWarriorEnemyCharacter> InSoftEnemyClass);
+
+	void ScheduleSummonQueueProcessing();
+	void ProcessSummonQueue();
+	void ProcessSummonRequest(FWarriorEnemySummonRequest& InSummonRequest);
+
+	// 返回false表示该预热请求已经完成
+	bool ProcessPrewarmRequest(const FWarriorEnemyPrewarmRequest& InPrewarmRequest);
+
+	UPROPERTY()
+	TMap<TSoftClassPtr<AWarriorEnemyCharacter>, FWarriorEnemyPoolBucket> EnemyPoolBuckets;
+
+	FWarriorEnemyPoolStats EnemyPoolStats;
+
+	// 每个类别最多保留的休眠敌人数量，超出的敌人直接销毁
+	int32 MaxDormantEnemiesPerClass {32};
+
+	TMap<TSoftClassPtr<AWarriorEnemyCharacter>, TSharedPtr<FStreamableHandle>> EnemyClassLoadHandles;
+
+	TMap<TSoftClassPtr<AWarriorEnemyCharacter>, TArray<FStreamableDelegate>> PendingClassLoadCallbacks;
+
+	TArray<FWarriorEnemySummonRequest> PendingSummonRequests;
+
+	TArray<FWarriorEnemyPrewarmRequest> PendingPrewarmRequests;
+
+	bool bSummonQueueProcessingScheduled {false};
+
+	// 每帧最多处理的召唤与预热数量
+	int32 MaxSummonSpawnsPerFrame {2};
+
+	// 每帧用于召唤与预热的时间预算（毫秒），每帧至少处理一个请求
+	float SummonFrameBudgetMs {1.f};
+};
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorEnemyRegistrySubsystem.generated.h"
+
+class AWarriorEnemyCharacter;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnemyRegisteredDelegate, AWarriorEnemyCharacter* /*RegisteredEnemy*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnEnemyUnregisteredDelegate, AWarriorEnemyCharacter* /*UnregisteredEnemy*/, bool /*bWasWaveEnemy*/);
+
+/**
+ * @brief 存活敌人登记表
+ *
+ * 以紧凑数组保存当前所有活跃的 AWarriorEnemyCharacter，敌人自身记录所在下标，登记与注销均为 O(1)
+ * 位置、阵营、死亡状态与类别编号以结构数组（SoA）的形式另存一份，每帧刷新一次
+ * 范围查询只遍历这些连续数组，不再依赖物理检测
+ *
+ * 敌人在 BeginPlay 与从对象池取出时登记，在回收进池与 EndPlay 时注销
+ */
+UCLASS()
+class WARRIOR_API UWarriorEnemyRegistrySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+	void RegisterEnemy(AWarriorEnemyCharacter* InEnemy);
+	void UnregisterEnemy(AWarriorEnemyCharacter* InEnemy);
+
+	// 标记该敌人计入生存模式的当前波次，未登记的敌人会先被登记
+	void MarkEnemyAsWaveEnemy(AWarriorEnemyCharacter* InEnemy);
+
+	// 取消波次标记，之后注销时广播的 bWasWaveEnemy 为 false；敌人转为其他形式继续计入波次时使用
+	void UnmarkWaveEnemy(AWarriorEnemyCharacter* InEnemy);
+
+	// 半径内的敌人，默认排除已死亡的敌人
+	void QueryEnemiesInRadius(const FVector& InOrigin, float InRadius, TArray<AWarriorEnemyCharacter*>& OutEnemies, bool bIncludeDead = false) const;
+
+	// 以 InDirection 为轴、半角为 InHalfAngleDegrees 的圆锥内的敌人
+	void QueryEnemiesInCone(const FVector& InOrigin, const FVector& InDirection, float InRadius, float InHalfAngleDegrees,
+		TArray<AWarriorEnemyCharacter*>& OutEnemies, bool bIncludeDead = false) const;
+
+	// 有向包围盒内的敌人，InHalfExtent 为盒子局部空间的半尺寸
+	void QueryEnemiesInBox(const FVector& InCenter, const FQuat& InRotation, const FVector& InHalfExtent,
+		TArray<AWarriorEnemyCharacter*>& OutEnemies, bool bIncludeDead = false) const;
+
+	AWarriorEnemyCharacter* FindNearestEnemy(const FVector& InOrigin, float InMaxRadius, bool bIncludeDead = false) const;
+
+	FORCEINLINE int32 GetNumRegisteredEnemies() const
+	{
+		return RegisteredEnemies.Num();
+	}
+
+	FORCEINLINE int32 GetNumWaveEnemies() const
+	{
+		return NumWaveEnemies;
+	}
+
+	FORCEINLINE const TArray<AWarriorEnemyCharacter*>& GetRegisteredEnemies() const
+	{
+		return RegisteredEnemies;
+	}
+
+	FORCEINLINE const TArray<FVector>& GetEnemyLocations() const
+	{
+		return EnemyLocations;
+	}
+
+	FORCEINLINE bool IsEnemyDeadAt(int32 InRegistryIndex) const
+	{
+		return EnemyDeadFlags[InRegistryIndex] != 0;
+	}
+
+	FORCEINLINE bool IsWaveEnemyAt(int32 InRegistryIndex) const
+	{
+		return EnemyWaveFlags[InRegistryIndex] != 0;
+	}
+
+	FORCEINLINE uint8 GetEnemyTeamIdAt(int32 InRegistryIndex) const
+	{
+		return EnemyTeamIds[InRegistryIndex];
+	}
+
+	FORCEINLINE int32 GetEnemyClassIdAt(int32 InRegistryIndex) const
+	{
+		return EnemyClassIds[InRegistryIndex];
+	}
+
+	FOnEnemyRegisteredDelegate OnEnemyRegistered;
+
+	// 敌人死亡回收、销毁或因其他原因离开登记表时广播
+	FOnEnemyUnregisteredDelegate OnEnemyUnregistered;
+
+private:
+	void RefreshEnemyDataAt(int32 InRegistryIndex);
+	int32 GetOrAddEnemyClassId(const UClass* InEnemyClass);
+
+	UPROPERTY()
+	TArray<AWarriorEnemyCharacter*> RegisteredEnemies;
+
+	// 以下数组与 RegisteredEnemies 一一对应
+	TArray<FVector> EnemyLocations;
+	TArray<uint8> EnemyTeamIds;
+	TArray<uint8> EnemyDeadFlags;
+	TArray<uint8> EnemyWaveFlags;
+	TArray<int32> EnemyClassIds;
+
+	TMap<const UClass*, int32> EnemyClassIdMap;
+
+	int32 NumWaveEnemies {0};
+};
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorEnemySignificanceSubsystem.generated.h"
+
+class AWarriorEnemyCharacter;
+class IAnimationBudgetAllocator;
+
+/**
+ * @brief 敌人重要度分级
+ *
+ * 每隔 EvaluationInterval 遍历存活敌人登记表，按与玩家的距离、屏幕占比与是否正在交战把敌人分为 High/Medium/Low 三级
+ * 每一级可以限制容纳数量，超出的敌人按距离降级；级别变化时由敌人自身调整各组件的更新频率
+ * 启用动画预算时，同时按与玩家的距离为敌人网格体设置动画预算分配器的重要度
+ */
+UCLASS()
+class WARRIOR_API UWarriorEnemySignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface.
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+	// 立即重新分级所有存活敌人
+	void EvaluateSignificance();
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Significance")
+	int32 GetNumEnemiesInTier(EWarriorEnemySignificanceTier InTier) const
+	{
+		return InTier < EWarriorEnemySignificanceTier::MAX ? NumEnemiesPerTier[static_cast<int32>(InTier)] : 0;
+	}
+
+private:
+	struct FSignificanceCandidate
+	{
+		AWarriorEnemyCharacter* Enemy;
+		float DistanceSquared;
+		EWarriorEnemySignificanceTier DesiredTier;
+		bool bCombatRelevant;
+	};
+
+	const FWarriorSignificanceTierSettings& GetTierSettings(EWarriorEnemySignificanceTier InTier) const;
+
+	// 按游戏模式配置与 warrior.AnimationBudget 启用或关闭动画预算分配器，状态未变化时不做任何事
+	void RefreshAnimationBudget();
+
+	FWarriorEnemySignificanceSettings SignificanceSettings;
+
+	FWarriorAnimationBudgetSettings AnimationBudgetSettings;
+
+	bool bAnimationBudgetEnabled {false};
+
+	// 复用的候选数组，避免每次分级分配内存
+	TArray<FSignificanceCandidate> SignificanceCandidates;
+
+	int32 NumEnemiesPerTier[static_cast<int32>(EWarriorEnemySignificanceTier::MAX)] {};
+
+	float TimeSinceLastEvaluation {0.f};
+};
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorHeroTargetLocatorSubsystem.generated.h"
+
+class AWarriorAIController;
+
+/**
+ * @brief 共享的玩家目标定位
+ *
+ * 唯一的敌对目标是玩家，因此不再让每个敌人控制器各自做360度视觉检测
+ * 每隔 EvaluationInterval 把视觉半径内尚无目标的敌人按网格分组，每组从代表点向玩家做一次视线检测
+ * 检测按 MaxTracesPerFrame 分摊到多帧完成，看到玩家的组内所有敌人写入黑板的 TargetActor
+ * 开销随检测预算而不是敌人数量增长
+ */
+UCLASS()
+class WARRIOR_API UWarriorHeroTargetLocatorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface.
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Target Locator")
+	bool IsTargetLocatorEnabled() const
+	{
+		return LocatorSettings.bEnableTargetLocator;
+	}
+
+private:
+	// 一组共用视线检测的敌人
+	struct FLocatorCluster
+	{
+		FVector TraceStart;
+		bool bHasLineOfSight;
+	};
+
+	struct FLocatorCandidate
+	{
+		TWeakObjectPtr<AWarriorAIController> AIController;
+		int32 ClusterIndex;
+	};
+
+	// 收集本轮需要检测的敌人并分组
+	void BeginLocatorPass(const APawn* InHeroPawn);
+
+	// 在预算内继续本轮的视线检测，全部完成时返回 true
+	bool ProcessPendingTraces(const APawn* InHeroPawn);
+
+	// 把看到玩家的结果写入各敌人的黑板
+	void ApplyLocatorResults(APawn* InHeroPawn);
+
+	FWarriorHeroTargetLocatorSettings LocatorSettings;
+
+	// 以下数组在各轮之间复用，避免每轮分配内存
+	TArray<FLocatorCluster> LocatorClusters;
+	TArray<FLocatorCandidate> LocatorCandidates;
+	TMap<FIntVector, int32> ClusterIndexByCell;
+
+	int32 NextClusterToTrace {0};
+
+	bool bLocatorPassInProgress {false};
+
+	float TimeSinceLastPass {0.f};
+};
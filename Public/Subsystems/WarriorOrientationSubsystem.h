@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorOrientationSubsystem.generated.h"
+
+// 转向请求结束时调用，bSucceeded 为 false 表示角色或目标已失效
+DECLARE_DELEGATE_OneParam(FOnOrientRequestFinishedDelegate, bool /*bSucceeded*/);
+
+/**
+ * @brief 批量转向系统
+ *
+ * 行为树节点只登记一次转向请求（角色、目标与插值速度），不再各自每帧读取黑板并旋转角色
+ * 每帧先把所有请求的角色与目标位置收集到连续数组，再一次性算出新的朝向并应用
+ * 设置了角度精度的请求在朝向目标后结束，并通过回调通知发起者
+ */
+UCLASS()
+class WARRIOR_API UWarriorOrientationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+	/**
+	 * @brief 登记转向请求
+	 *
+	 * @param InPawn 需要转向的角色
+	 * @param InTargetActor 转向的目标
+	 * @param InRotationInterpSpeed 旋转插值速度
+	 * @param InAnglePrecision 与目标方向的夹角不超过该值（度）时请求结束，小于0表示持续转向直到被移除
+	 * @param InOnFinished 请求结束时的回调，回调前请求已被移除
+	 * @return 请求编号，0表示登记失败
+	 */
+	uint32 AddOrientRequest(APawn* InPawn, AActor* InTargetActor, float InRotationInterpSpeed, float InAnglePrecision = -1.f,
+		FOnOrientRequestFinishedDelegate InOnFinished = FOnOrientRequestFinishedDelegate());
+
+	// 更换请求的目标，请求不存在（例如已因角色失效而结束）时返回 false
+	bool UpdateOrientRequestTarget(uint32 InRequestId, AActor* InTargetActor);
+
+	// 移除请求，不会调用结束回调
+	void RemoveOrientRequest(uint32 InRequestId);
+
+	// 角色是否已经在夹角精度内朝向目标
+	static bool IsFacingTarget(const APawn* InPawn, const AActor* InTargetActor, float InAnglePrecision);
+
+	FORCEINLINE int32 GetNumOrientRequests() const
+	{
+		return RequestIds.Num();
+	}
+
+private:
+	void RemoveOrientRequestAt(int32 InRequestIndex);
+
+	// 请求数据以结构数组形式保存，移除时与末尾元素交换
+	TArray<uint32> RequestIds;
+	TArray<TWeakObjectPtr<APawn>> RequestPawns;
+	TArray<TWeakObjectPtr<AActor>> RequestTargets;
+	TArray<float> RequestInterpSpeeds;
+
+	// 结束所需的最小朝向点积，即精度角的余弦；持续转向的请求为一个不可能达到的值
+	TArray<float> RequestMinFacingDots;
+	TArray<FOnOrientRequestFinishedDelegate> RequestFinishedDelegates;
+
+	TMap<uint32, int32> RequestIndexById;
+
+	// 每帧复用的中间数组
+	TArray<FVector> PawnLocations;
+	TArray<FVector> TargetLocations;
+	TArray<FRotator> PawnRotations;
+	TArray<uint8> RequestValidFlags;
+	TArray<TPair<uint32, bool>> FinishedRequests;
+	TArray<TPair<FOnOrientRequestFinishedDelegate, bool>> FinishedCallbacks;
+
+	uint32 NextRequestId {1};
+};
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorPopulationDirectorSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnConcurrentEnemyCapChangedDelegate, int32 /*NewConcurrentEnemyCap*/);
+
+USTRUCT(BlueprintType)
+struct FWarriorPopulationDirectorStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 ConcurrentEnemyCap {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	float SmoothedGameThreadMs {0.f};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 CapRaisedCount {0};
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 CapLoweredCount {0};
+
+	// 因达到上限而推迟的生成次数
+	UPROPERTY(BlueprintReadOnly)
+	int32 DeferredSpawnDecisions {0};
+};
+
+/**
+ * @brief 敌人数量调度
+ *
+ * 根据平滑后的游戏线程帧时间与配置的预算，自适应调整同时存活的敌人上限
+ * 超出预算时逐步降低上限，帧时间充裕时逐步恢复，性能较弱的机器会推迟补充生成而不是掉帧
+ */
+UCLASS()
+class WARRIOR_API UWarriorPopulationDirectorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface.
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+	// 当前存活 InNumLiveEnemies 个敌人时是否还能再生成一个，不能时记录一次推迟
+	bool RequestSpawnSlot(int32 InNumLiveEnemies);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|PopulationDirector")
+	int32 GetConcurrentEnemyCap() const
+	{
+		return ConcurrentEnemyCap;
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|PopulationDirector")
+	FWarriorPopulationDirectorStats GetPopulationDirectorStats() const
+	{
+		return DirectorStats;
+	}
+
+	FOnConcurrentEnemyCapChangedDelegate OnConcurrentEnemyCapChanged;
+
+private:
+	void AdjustConcurrentEnemyCap();
+
+	FWarriorPopulationDirectorSettings DirectorSettings;
+
+	FWarriorPopulationDirectorStats DirectorStats;
+
+	int32 ConcurrentEnemyCap {0};
+
+	float SmoothedGameThreadMs {0.f};
+
+	float TimeSinceLastCapAdjust {0.f};
+};
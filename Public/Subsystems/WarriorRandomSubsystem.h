@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
+#include "WarriorRandomSubsystem.generated.h"
+
+/**
+ * @brief 可复现的随机数来源
+ *
+ * 命令行带有 -WarriorSeed=<整数> 时进入种子模式，波次组成、刷怪点与能力选择的随机结果在每次运行中完全一致
+ * 未指定种子时使用随机的基础种子，行为与直接调用 FMath::RandRange 相同
+ */
+UCLASS()
+class WARRIOR_API UWarriorRandomSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	//~ End USubsystem Interface.
+
+	FRandomStream& GetStream(EWarriorRandomStream InStream)
+	{
+		return RandomStreams[static_cast<int32>(InStream)];
+	}
+
+	// 世界上下文不可用（例如编辑器预览中的ASC）时退化为全局随机数
+	static int32 RandRange(const UObject* WorldContextObject, EWarriorRandomStream InStream, int32 InMin, int32 InMax);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Random")
+	bool IsSeededMode() const
+	{
+		return bSeededMode;
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Random")
+	int32 GetBaseSeed() const
+	{
+		return BaseSeed;
+	}
+
+private:
+	FRandomStream RandomStreams[static_cast<int32>(EWarriorRandomStream::MAX)];
+
+	int32 BaseSeed {0};
+
+	bool bSeededMode {false};
+};
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorSoakBenchmarkSubsystem.generated.h"
+
+class AWarriorSurvivalGameMode;
+
+// 单个波次的性能记录
+USTRUCT()
+struct FWarriorSoakWaveReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 WaveCount {0};
+
+	UPROPERTY()
+	int32 NumFrames {0};
+
+	UPROPERTY()
+	float WaveDurationSeconds {0.f};
+
+	UPROPERTY()
+	float FrameTimeP50Ms {0.f};
+
+	UPROPERTY()
+	float FrameTimeP95Ms {0.f};
+
+	UPROPERTY()
+	float FrameTimeP99Ms {0.f};
+
+	UPROPERTY()
+	float FrameTimeMaxMs {0.f};
+
+	UPROPERTY()
+	float GameThreadTimeP95Ms {0.f};
+
+	// 有敌人生成的帧中最长的一帧
+	UPROPERTY()
+	float MaxSpawnHitchMs {0.f};
+
+	UPROPERTY()
+	int32 MaxLiveObjects {0};
+
+	UPROPERTY()
+	int32 MaxLiveActors {0};
+
+	UPROPERTY()
+	float PeakUsedPhysicalMB {0.f};
+};
+
+/**
+ * @brief 生存模式无界面浸泡测试
+ *
+ * 仅在命令行带有 -WarriorSoak 时创建，例如：
+ * UnrealEditor-Cmd Warrior.uproject SurvivalMap -game -nullrhi -unattended -WarriorSoak
+ *
+ * 英雄获得无敌标签，敌人按固定间隔直接结束死亡流程，依次跑完所有波次
+ * 每一波记录帧时间百分位、生成卡顿峰值、存活UObject/Actor数量与内存峰值
+ * 结果以CSV与JSON写入 Saved/Profiling/WarriorSoak，并可与基线CSV按容差比较
+ *
+ * 可选参数：
+ * -WarriorSoakBaseline=<csv路径>  -WarriorSoakTolerance=0.1  -WarriorSoakKillInterval=0.5
+ * -WarriorSoakWaveTimeScale=10  -WarriorSoakTimeout=1800
+ */
+UCLASS()
+class WARRIOR_API UWarriorSoakBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	//~ End USubsystem Interface.
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface.
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface.
+
+private:
+	void BeginSoakRun();
+	void BeginWaveRecording(int32 InWaveCount);
+	void RecordFrame(float InFrameTimeMs);
+	void EndWaveRecording();
+	void KillOneLiveEnemy();
+	void FinishSoakRun(const FString& InReason);
+	void WriteReports(const FString& InBaseFileName) const;
+	int32 CompareAgainstBaseline() const;
+
+	static float GetPercentile(const TArray<float>& InSortedSamples, float InPercentile);
+
+	UPROPERTY()
+	AWarriorSurvivalGameMode* SurvivalGameMode;
+
+	UPROPERTY()
+	TArray<FWarriorSoakWaveReport> WaveReports;
+
+	FWarriorSoakWaveReport CurrentWaveReport;
+
+	TArray<float> CurrentWaveFrameTimesMs;
+	TArray<float> CurrentWaveGameThreadTimesMs;
+
+	FString BaselineFilePath;
+	float RegressionTolerance {0.1f};
+	float KillIntervalSeconds {0.5f};
+	float WaveFlowTimeScale {10.f};
+	float TimeoutSeconds {1800.f};
+
+	double SoakStartTimeSeconds {0.0};
+	double WaveStartTimeSeconds {0.0};
+	double LastFrameTimeSeconds {0.0};
+	float TimeSinceLastKill {0.f};
+	int32 LastSpawnedFromQueue {0};
+	int32 FramesSinceMemorySample {0};
+
+	bool bSoakRunStarted {false};
+	bool bSoakRunFinished {false};
+	bool bRecordingWave {false};
+};
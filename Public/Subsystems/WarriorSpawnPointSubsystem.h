@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameModes/WarriorBaseGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorSpawnPointSubsystem.generated.h"
+
+class ANavigationData;
+struct FNavLocation;
+
+// 一个 ATargetPoint 对应的缓存区间，指向 CachedGroundLocations 中的连续一段
+USTRUCT()
+struct FWarriorSpawnAnchor
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector AnchorLocation {FVector::ZeroVector};
+
+	UPROPERTY()
+	FRotator AnchorRotation {FRotator::ZeroRotator};
+
+	UPROPERTY()
+	int32 FirstPointIndex {0};
+
+	UPROPERTY()
+	int32 NumPoints {0};
+};
+
+/**
+ * @brief 刷怪点缓存
+ *
+ * 世界开始时在每个 ATargetPoint 周围采样若干个导航可达并贴地的点，存放在连续数组中
+ * 生成敌人时只需 O(1) 随机取点，不再在游戏线程上做导航查询，也不需要 +150 的下落偏移
+ * 导航网格重建完成后合并短时间内的多次重建，延迟 NavigationRebuildDelay 秒后重新采样
+ */
+UCLASS()
+class WARRIOR_API UWarriorSpawnPointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface.
+
+	// 重新采样所有 ATargetPoint 周围的刷怪点
+	void RebuildSpawnPointCache();
+
+	// 随机选择一个 ATargetPoint 并返回其缓存的贴地位置与朝向
+	bool PickWaveSpawnPoint(FVector& OutGroundLocation, FRotator& OutRotation) const;
+
+	// 在缓存中寻找 InOrigin 半径 InRadius 内的随机点，缓存中没有合适的点时退化为一次导航查询
+	bool FindSpawnPointNear(const FVector& InOrigin, float InRadius, FVector& OutGroundLocation) const;
+
+	// 根据敌人类的胶囊体半高，把贴地位置抬升到角色中心的生成位置
+	static FVector GetSpawnLocationForEnemyClass(const FVector& InGroundLocation, const UClass* InEnemyClass);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|SpawnPoint")
+	bool HasSpawnAnchors() const
+	{
+		return !SpawnAnchors.IsEmpty();
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|SpawnPoint")
+	int32 GetNumCachedSpawnPoints() const
+	{
+		return CachedGroundLocations.Num();
+	}
+
+private:
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	bool TrySampleNavigablePoint(const FVector& InOrigin, float InRadius, FRandomStream& InRandomStream, FNavLocation& OutNavLocation) const;
+	bool TrySnapToGround(const FVector& InLocation, FVector& OutGroundLocation) const;
+
+	FWarriorSpawnPointCacheSettings CacheSettings;
+
+	UPROPERTY()
+	TArray<FWarriorSpawnAnchor> SpawnAnchors;
+
+	UPROPERTY()
+	TArray<FVector> CachedGroundLocations;
+
+	FTimerHandle NavigationRebuildTimerHandle;
+};
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "GameModes/WarriorSurvivalGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorWaveStreamingSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWaveAssetsReadyDelegate, int32 /*WaveIndex*/);
+
+/**
+ * @brief 波次资源流送
+ *
+ * 持有敌人类别的 FStreamableHandle，防止即将使用的类别被GC卸载
+ * 在内存预算内提前加载当前波次之后的若干波，并释放后续波次不再引用的类别
+ * 波次下标从0开始，与 FWarriorCompiledWaveSchedule::WavePlans 一致
+ * 加载失败的类别记录错误并视为已处理，波次照常就绪，由游戏模式跳过该类别的刷怪
+ */
+UCLASS()
+class WARRIOR_API UWarriorWaveStreamingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface.
+
+	// 设置要流送的波次计划，会释放之前持有的所有句柄
+	void InitializeWaveSchedule(const FWarriorCompiledWaveSchedule& InWaveSchedule);
+
+	// 以 InCurrentWaveIndex 为起点重新计算需要常驻的类别，发起加载并释放不再需要的类别
+	void UpdateStreaming(int32 InCurrentWaveIndex);
+
+	// 该波次引用的所有敌人类别是否都已加载完成或确认加载失败
+	bool IsWaveReady(int32 InWaveIndex) const;
+
+	// 该类别的加载请求已结束但没有得到可用的类
+	bool IsEnemyClassFailed(int32 InEnemyClassIndex) const
+	{
+		return FailedEnemyClasses.IsValidIndex(InEnemyClassIndex) && FailedEnemyClasses[InEnemyClassIndex];
+	}
+
+	UClass* GetLoadedEnemyClass(int32 InEnemyClassIndex) const
+	{
+		return LoadedEnemyClasses.IsValidIndex(InEnemyClassIndex) ? LoadedEnemyClasses[InEnemyClassIndex] : nullptr;
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|WaveStreaming")
+	int32 GetNumLoadedEnemyClasses() const;
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|WaveStreaming")
+	float GetRetainedMemoryMB() const;
+
+	// 某一波次的全部类别加载完成时广播
+	FOnWaveAssetsReadyDelegate OnWaveAssetsReady;
+
+private:
+	void RequestEnemyClassLoad(int32 InEnemyClassIndex);
+	void ReleaseEnemyClass(int32 InEnemyClassIndex);
+	void OnEnemyClassLoaded(int32 InEnemyClassIndex);
+	int64 GetEstimatedClassMemoryBytes(int32 InEnemyClassIndex) const;
+
+	FWarriorWaveStreamingSettings StreamingSettings;
+
+	UPROPERTY()
+	FWarriorCompiledWaveSchedule WaveSchedule;
+
+	// 以下数组都与 WaveSchedule.EnemyClasses 一一对应
+	TArray<TSharedPtr<FStreamableHandle>> EnemyClassHandles;
+
+	UPROPERTY()
+	TArray<UClass*> LoadedEnemyClasses;
+
+	TArray<bool> FailedEnemyClasses;
+
+	int32 CurrentWaveIndex {0};
+};
@@ -0,0 +1,8 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+// 生存模式相关的性能统计，控制台输入 stat WarriorSurvival 查看
+DECLARE_STATS_GROUP(TEXT("WarriorSurvival"), STATGROUP_WarriorSurvival, STATCAT_Advanced);
@@ -56,5 +56,53 @@ enum class EWarriorInputMode : uint8
 	UIOnly,
 };
 
+// 各个随机数流的用途，每个流由同一个基础种子派生，互不干扰
+UENUM()
+enum class EWarriorRandomStream : uint8
+{
+	WaveComposition,
+	SpawnPoint,
+	AbilityChoice,
+	MAX UMETA(Hidden)
+};
+
+// 敌人重要度分级，级别越低各组件更新越稀疏，MAX 表示尚未分级
+UENUM(BlueprintType)
+enum class EWarriorEnemySignificanceTier : uint8
+{
+	High,
+	Medium,
+	Low,
+	MAX UMETA(Hidden)
+};
+
+// 敌人的群体避让等级，Off 表示只作为障碍物参与避让、自身不做避让计算，MAX 表示尚未分配
+UENUM(BlueprintType)
+enum class EWarriorCrowdAvoidanceLevel : uint8
+{
+	High,
+	Medium,
+	Low,
+	Off,
+	MAX UMETA(Hidden)
+};
+
+// 围攻玩家时的攻击名额类型
+UENUM(BlueprintType)
+enum class EWarriorAttackTokenType : uint8
+{
+	Melee,
+	Ranged,
+	MAX UMETA(Hidden)
+};
+
+// 敌人AI使用的决策方式
+UENUM(BlueprintType)
+enum class EWarriorEnemyBrainType : uint8
+{
+	BehaviorTree,
+	StateTree
+};
+
 
 
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/WarriorWidgetBase.h"
+#include "WarriorEnemyHealthBarLayerWidget.generated.h"
+
+// 一条待绘制的血条，位置为本控件局部空间中血条的中心
+struct FWarriorHealthBarDrawElement
+{
+	FVector2D LocalPosition;
+	float HealthPercent;
+};
+
+/**
+ * @brief 敌人血条批量绘制层
+ *
+ * 由本地英雄控制器加入视口的全屏控件，每帧一次遍历存活敌人登记表，投影到屏幕并剔除屏幕外的敌人
+ * 血量读取自 UEnemyUIComponent 缓存的百分比，所有血条在 NativePaint 中直接绘制，开销只与可见血条数量相关
+ * 开启 warrior.BatchedEnemyHealthBars 后敌人不再为各自的 UWidgetComponent 创建血条用户控件
+ * 该变量在关卡开始前读取，运行中切换只影响之后生成的敌人
+ */
+UCLASS()
+class WARRIOR_API UWarriorEnemyHealthBarLayerWidget : public UWarriorWidgetBase
+{
+	GENERATED_BODY()
+
+public:
+	// 是否由血条层统一绘制敌人血条
+	static bool IsBatchedHealthBarEnabled();
+
+protected:
+	//~ Begin UUserWidget Interface.
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	//~ End UUserWidget Interface.
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FSlateBrush BackgroundBrush;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FSlateBrush FillBrush;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FLinearColor BackgroundColor {FLinearColor(0.f, 0.f, 0.f, 0.6f)};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FLinearColor FillColor {FLinearColor(0.8f, 0.05f, 0.05f, 1.f)};
+
+	// 血条在本控件局部空间中的尺寸
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FVector2D BarSize {FVector2D(80.f, 8.f)};
+
+	// 血条锚点相对敌人位置的世界空间高度
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	float BarWorldHeightOffset {120.f};
+
+	// 超过该距离的敌人不绘制血条
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	float MaxDrawDistance {3000.f};
+
+	// 只为受过伤的敌人绘制血条
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	bool bOnlyDrawDamagedEnemies {false};
+
+private:
+	// 每帧复用的绘制列表，只在可见血条数量增长时分配内存
+	TArray<FWarriorHealthBarDrawElement> HealthBarDrawElements;
+};